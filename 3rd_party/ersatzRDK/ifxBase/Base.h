@@ -53,19 +53,25 @@ extern "C"
 
 #include <stddef.h>
 
+#include <ifxBase/CFAR.h>
 #include <ifxBase/Complex.h>
 #include <ifxBase/Cube.h>
 #include <ifxBase/Defines.h>
 #include <ifxBase/Error.h>
+#include <ifxBase/FFT.h>
 #include <ifxBase/LA.h>
 #include <ifxBase/List.h>
 #include <ifxBase/Log.h>
 #include <ifxBase/Math.h>
 #include <ifxBase/Matrix.h>
+#include <ifxBase/MedianFilter.h>
 #include <ifxBase/Mem.h>
+#include <ifxBase/MTI.h>
+#include <ifxBase/RangeDoppler.h>
 #include <ifxBase/Types.h>
 #include <ifxBase/Uuid.h>
 #include <ifxBase/Vector.h>
+#include <ifxBase/Window.h>
 
 
 #ifdef __cplusplus
@@ -0,0 +1,668 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ifxBase/CFAR.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Mem.h"
+#include "ifxBase/internal/Macros.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/* Number of 64 bit words of the rank bitmap per population count */
+#define CFAR_BLOCK_WORDS 16
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/** Input cells, cell (r, c) is data[r * row_stride + c * col_stride]. A
+ *  vector is a map with a single row and no window along the rows. */
+typedef struct
+{
+    const ifx_Float_t* data;
+    size_t row_stride;
+    size_t col_stride;
+    int32_t rows;
+    int32_t cols;
+    int32_t guard_rows;
+    int32_t training_rows;
+} cfar_map_t;
+
+typedef struct
+{
+    ifx_Float_t value;
+    uint32_t index;
+} cfar_rank_t;
+
+struct ifx_CFAR_s
+{
+    ifx_CFAR_Type_t type;
+    uint32_t num_rows;
+    uint32_t num_cols;
+    int32_t guard_cols;
+    int32_t training_cols;
+    int32_t guard_rows;
+    int32_t training_rows;
+    ifx_Float_t threshold_factor;
+    uint32_t os_rank;
+
+    ifx_Float_t* threshold;     /**< Threshold of every cell, [row][col] */
+
+    double* table;              /**< Summed area table of (num_rows + 1) x (num_cols + 1), CA, GO and SO */
+
+    cfar_rank_t* sorted;        /**< Cells in ascending order, OS */
+    uint32_t* rank;             /**< Position of every cell in sorted, [col][row] as the window
+                                     takes and drops cells column by column, OS */
+    uint64_t* bitmap;           /**< Bit n is set while the cell of rank n is in the window, OS */
+    uint32_t* block_count;      /**< Set bits per CFAR_BLOCK_WORDS words of the bitmap, OS */
+    uint32_t num_blocks;
+    uint32_t window_count;      /**< Number of cells in the window */
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static inline int32_t clamp_low(int32_t v, int32_t low) { return (v < low) ? low : v; }
+
+static inline int32_t clamp_high(int32_t v, int32_t high) { return (v > high) ? high : v; }
+
+static uint32_t training_cells(int32_t guard_rows, int32_t training_rows,
+                               int32_t guard_cols, int32_t training_cols);
+
+static void build_table(ifx_CFAR_t* handle, const cfar_map_t* map);
+
+static double rect_sum(const ifx_CFAR_t* handle, const cfar_map_t* map,
+                       int32_t r0, int32_t r1, int32_t c0, int32_t c1, uint32_t* count);
+
+static void threshold_averaging(ifx_CFAR_t* handle, const cfar_map_t* map);
+
+static int compare_rank(const void* a, const void* b);
+
+static inline uint32_t popcount64(uint64_t x);
+
+static inline uint32_t select64(uint64_t x, uint32_t k);
+
+static inline void window_update(ifx_CFAR_t* handle, uint32_t rank, int32_t delta);
+
+static uint32_t window_find(const ifx_CFAR_t* handle, uint32_t k);
+
+static void update_column(ifx_CFAR_t* handle, const cfar_map_t* map,
+                          int32_t r, int32_t c, int32_t j, int32_t delta);
+
+static void update_guard_rows(ifx_CFAR_t* handle, const cfar_map_t* map,
+                              int32_t r, int32_t j, int32_t delta);
+
+static void threshold_ordered(ifx_CFAR_t* handle, const cfar_map_t* map);
+
+static void compute_threshold(ifx_CFAR_t* handle, const cfar_map_t* map);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static uint32_t training_cells(int32_t guard_rows, int32_t training_rows,
+                               int32_t guard_cols, int32_t training_cols)
+{
+    const uint32_t outer = (uint32_t)(2 * (guard_rows + training_rows) + 1) *
+                           (uint32_t)(2 * (guard_cols + training_cols) + 1);
+    const uint32_t guard = (uint32_t)(2 * guard_rows + 1) * (uint32_t)(2 * guard_cols + 1);
+
+    return outer - guard;
+}
+
+//----------------------------------------------------------------------------
+
+static void build_table(ifx_CFAR_t* handle, const cfar_map_t* map)
+{
+    const size_t width = (size_t)map->cols + 1;
+    double* table = handle->table;
+
+    memset(table, 0, width * sizeof(double));
+
+    for (int32_t r = 0; r < map->rows; r++)
+    {
+        const ifx_Float_t* row = map->data + r * map->row_stride;
+        const double* above = table + r * width;
+        double* t = table + (r + 1) * width;
+        double row_sum = 0;
+
+        t[0] = 0;
+        for (int32_t c = 0; c < map->cols; c++)
+        {
+            row_sum += row[c * map->col_stride];
+            t[c + 1] = above[c + 1] + row_sum;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/* Sum and number of the cells in rows r0..r1 and columns c0..c1, clipped to
+ * the map */
+static double rect_sum(const ifx_CFAR_t* handle, const cfar_map_t* map,
+                       int32_t r0, int32_t r1, int32_t c0, int32_t c1, uint32_t* count)
+{
+    r0 = clamp_low(r0, 0);
+    c0 = clamp_low(c0, 0);
+    r1 = clamp_high(r1, map->rows - 1);
+    c1 = clamp_high(c1, map->cols - 1);
+
+    if ((r0 > r1) || (c0 > c1))
+    {
+        *count = 0;
+        return 0;
+    }
+
+    const size_t width = (size_t)map->cols + 1;
+    const double* t = handle->table;
+
+    *count = (uint32_t)((r1 - r0 + 1) * (c1 - c0 + 1));
+    return t[(r1 + 1) * width + c1 + 1] - t[r0 * width + c1 + 1]
+         - t[(r1 + 1) * width + c0] + t[r0 * width + c0];
+}
+
+//----------------------------------------------------------------------------
+
+static void threshold_averaging(ifx_CFAR_t* handle, const cfar_map_t* map)
+{
+    const int32_t gr = map->guard_rows;
+    const int32_t wr = map->guard_rows + map->training_rows;
+    const int32_t gc = handle->guard_cols;
+    const int32_t wc = handle->guard_cols + handle->training_cols;
+
+    build_table(handle, map);
+
+    for (int32_t r = 0; r < map->rows; r++)
+    {
+        ifx_Float_t* threshold = handle->threshold + (size_t)r * map->cols;
+
+        for (int32_t c = 0; c < map->cols; c++)
+        {
+            uint32_t n_outer, n_guard;
+            double noise;
+
+            if (handle->type == IFX_CFAR_CA)
+            {
+                const double sum = rect_sum(handle, map, r - wr, r + wr, c - wc, c + wc, &n_outer)
+                                 - rect_sum(handle, map, r - gr, r + gr, c - gc, c + gc, &n_guard);
+                const uint32_t n = n_outer - n_guard;
+
+                noise = (n > 0) ? sum / n : INFINITY;
+            }
+            else
+            {
+                const double lead = rect_sum(handle, map, r - wr, r + wr, c - wc, c, &n_outer)
+                                  - rect_sum(handle, map, r - gr, r + gr, c - gc, c, &n_guard);
+                const uint32_t n_lead = n_outer - n_guard;
+                const double lag = rect_sum(handle, map, r - wr, r + wr, c, c + wc, &n_outer)
+                                 - rect_sum(handle, map, r - gr, r + gr, c, c + gc, &n_guard);
+                const uint32_t n_lag = n_outer - n_guard;
+
+                if ((n_lead == 0) && (n_lag == 0))
+                    noise = INFINITY;
+                else if (n_lead == 0)
+                    noise = lag / n_lag;
+                else if (n_lag == 0)
+                    noise = lead / n_lead;
+                else if (handle->type == IFX_CFAR_GO)
+                    noise = fmax(lead / n_lead, lag / n_lag);
+                else
+                    noise = fmin(lead / n_lead, lag / n_lag);
+            }
+
+            threshold[c] = (ifx_Float_t)(handle->threshold_factor * noise);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static int compare_rank(const void* a, const void* b)
+{
+    const cfar_rank_t* x = (const cfar_rank_t*)a;
+    const cfar_rank_t* y = (const cfar_rank_t*)b;
+
+    if (x->value != y->value)
+        return (x->value < y->value) ? -1 : 1;
+    return (x->index < y->index) ? -1 : (x->index > y->index);
+}
+
+//----------------------------------------------------------------------------
+
+static inline uint32_t popcount64(uint64_t x)
+{
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (uint32_t)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+/* Position of the k-th (from 1) set bit of x */
+static inline uint32_t select64(uint64_t x, uint32_t k)
+{
+    while (--k > 0)
+        x &= x - 1;
+
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_ctzll(x);
+#else
+    uint32_t pos = 0;
+    while (!(x & 1))
+    {
+        x >>= 1;
+        pos++;
+    }
+    return pos;
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+static inline void window_update(ifx_CFAR_t* handle, uint32_t rank, int32_t delta)
+{
+    const uint64_t bit = (uint64_t)1 << (rank & 63);
+
+    if (delta > 0)
+        handle->bitmap[rank / 64] |= bit;
+    else
+        handle->bitmap[rank / 64] &= ~bit;
+
+    handle->block_count[rank / (64 * CFAR_BLOCK_WORDS)] += (uint32_t)delta;
+    handle->window_count += (uint32_t)delta;
+}
+
+//----------------------------------------------------------------------------
+
+/* Rank of the k-th (from 1) smallest cell in the window */
+static uint32_t window_find(const ifx_CFAR_t* handle, uint32_t k)
+{
+    uint32_t block = 0;
+    while (handle->block_count[block] < k)
+        k -= handle->block_count[block++];
+
+    uint32_t word = block * CFAR_BLOCK_WORDS;
+    for (;;)
+    {
+        const uint32_t count = popcount64(handle->bitmap[word]);
+        if (count >= k)
+            break;
+        k -= count;
+        word++;
+    }
+
+    return word * 64 + select64(handle->bitmap[word], k);
+}
+
+//----------------------------------------------------------------------------
+
+/* Adds (delta 1) or removes (delta -1) the training cells of column j of the
+ * window around cell (r, c) */
+static void update_column(ifx_CFAR_t* handle, const cfar_map_t* map,
+                          int32_t r, int32_t c, int32_t j, int32_t delta)
+{
+    const int32_t distance = (j > c) ? j - c : c - j;
+
+    if ((j < 0) || (j >= map->cols) || (distance > handle->guard_cols + handle->training_cols))
+        return;
+
+    const int32_t wr = map->guard_rows + map->training_rows;
+    const int32_t first = clamp_low(r - wr, 0);
+    const int32_t last = clamp_high(r + wr, map->rows - 1);
+    const bool guarded = (distance <= handle->guard_cols);
+    const uint32_t* rank = handle->rank + (size_t)j * map->rows;
+
+    for (int32_t i = first; i <= last; i++)
+    {
+        if (guarded && (i >= r - map->guard_rows) && (i <= r + map->guard_rows))
+            continue;
+
+        window_update(handle, rank[i], delta);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/* Adds or removes the cells of column j in the guard rows around row r */
+static void update_guard_rows(ifx_CFAR_t* handle, const cfar_map_t* map,
+                              int32_t r, int32_t j, int32_t delta)
+{
+    if ((j < 0) || (j >= map->cols))
+        return;
+
+    const int32_t first = clamp_low(r - map->guard_rows, 0);
+    const int32_t last = clamp_high(r + map->guard_rows, map->rows - 1);
+    const uint32_t* rank = handle->rank + (size_t)j * map->rows;
+
+    for (int32_t i = first; i <= last; i++)
+        window_update(handle, rank[i], delta);
+}
+
+//----------------------------------------------------------------------------
+
+static void threshold_ordered(ifx_CFAR_t* handle, const cfar_map_t* map)
+{
+    const uint32_t size = (uint32_t)(map->rows * map->cols);
+    const int32_t gc = handle->guard_cols;
+    const int32_t wc = handle->guard_cols + handle->training_cols;
+    const uint32_t n_full = training_cells(map->guard_rows, map->training_rows, gc, handle->training_cols);
+    uint32_t k_full = (handle->os_rank != 0) ? handle->os_rank : (3 * n_full) / 4;
+
+    if (k_full > n_full)
+        k_full = n_full;
+    if (k_full == 0)
+        k_full = 1;
+
+    // rank all cells once, the window then only moves ranks in and out
+    for (int32_t r = 0; r < map->rows; r++)
+    {
+        for (int32_t c = 0; c < map->cols; c++)
+        {
+            cfar_rank_t* cell = &handle->sorted[r * map->cols + c];
+            cell->value = map->data[r * map->row_stride + c * map->col_stride];
+            cell->index = (uint32_t)(c * map->rows + r);
+        }
+    }
+    qsort(handle->sorted, size, sizeof(cfar_rank_t), compare_rank);
+
+    for (uint32_t i = 0; i < size; i++)
+        handle->rank[handle->sorted[i].index] = i;
+
+    memset(handle->bitmap, 0, (size_t)handle->num_blocks * CFAR_BLOCK_WORDS * sizeof(uint64_t));
+    memset(handle->block_count, 0, handle->num_blocks * sizeof(uint32_t));
+    handle->window_count = 0;
+
+    for (int32_t r = 0; r < map->rows; r++)
+    {
+        ifx_Float_t* threshold = handle->threshold + (size_t)r * map->cols;
+
+        for (int32_t j = 0; j <= wc; j++)
+            update_column(handle, map, r, 0, j, 1);
+
+        for (int32_t c = 0; c < map->cols; c++)
+        {
+            const uint32_t n = handle->window_count;
+
+            if (n == 0)
+            {
+                threshold[c] = INFINITY;
+            }
+            else
+            {
+                uint32_t k = (uint32_t)(((uint64_t)k_full * n + n_full - 1) / n_full);
+                if (k == 0)
+                    k = 1;
+                threshold[c] = handle->threshold_factor * handle->sorted[window_find(handle, k)].value;
+            }
+
+            if (c + 1 == map->cols)
+                break;
+
+            // moving the window by one cell: the first column leaves, a
+            // column enters, the guard rows of the column leaving the guard
+            // region become training cells and those of the column entering
+            // it stop being training cells
+            update_column(handle, map, r, c, c - wc, -1);
+            update_column(handle, map, r, c + 1, c + 1 + wc, 1);
+            if (gc < wc)
+            {
+                update_guard_rows(handle, map, r, c - gc, 1);
+                update_guard_rows(handle, map, r, c + 1 + gc, -1);
+            }
+        }
+
+        for (int32_t j = map->cols - 1 - wc; j < map->cols; j++)
+            update_column(handle, map, r, map->cols - 1, j, -1);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void compute_threshold(ifx_CFAR_t* handle, const cfar_map_t* map)
+{
+    if (handle->type == IFX_CFAR_OS)
+        threshold_ordered(handle, map);
+    else
+        threshold_averaging(handle, map);
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_CFAR_t* ifx_cfar_create(const ifx_CFAR_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_ARGUMENT((config->type != IFX_CFAR_CA) && (config->type != IFX_CFAR_GO) &&
+                         (config->type != IFX_CFAR_SO) && (config->type != IFX_CFAR_OS));
+    IFX_ERR_BRN_ARGUMENT((config->num_rows == 0) || (config->num_cols == 0));
+    IFX_ERR_BRN_ARGUMENT((config->num_rows > (1u << 15)) || (config->num_cols > (1u << 15)));
+    IFX_ERR_BRN_ARGUMENT((config->guard_cols + config->training_cols > (1u << 15)) ||
+                         (config->guard_rows + config->training_rows > (1u << 15)));
+    IFX_ERR_BRN_ARGUMENT((config->training_cols == 0) && (config->training_rows == 0));
+    IFX_ERR_BRN_ARGUMENT(!(config->threshold_factor > 0));
+
+    const uint32_t n_full = training_cells((int32_t)config->guard_rows, (int32_t)config->training_rows,
+                                           (int32_t)config->guard_cols, (int32_t)config->training_cols);
+    IFX_ERR_BRN_ARGUMENT((config->type == IFX_CFAR_OS) && (config->os_rank > n_full));
+
+    ifx_CFAR_t* handle = ifx_mem_calloc(1, sizeof(ifx_CFAR_t));
+    IFX_ERR_BRN_MEMALLOC(handle);
+
+    handle->type = config->type;
+    handle->num_rows = config->num_rows;
+    handle->num_cols = config->num_cols;
+    handle->guard_cols = (int32_t)config->guard_cols;
+    handle->training_cols = (int32_t)config->training_cols;
+    handle->guard_rows = (int32_t)config->guard_rows;
+    handle->training_rows = (int32_t)config->training_rows;
+    handle->threshold_factor = config->threshold_factor;
+    handle->os_rank = config->os_rank;
+
+    const size_t size = (size_t)config->num_rows * config->num_cols;
+    bool ok;
+
+    handle->threshold = ifx_mem_aligned_alloc(size * sizeof(ifx_Float_t), MEMORY_ALIGNMENT);
+    if (config->type == IFX_CFAR_OS)
+    {
+        handle->num_blocks = (uint32_t)((size + 64 * CFAR_BLOCK_WORDS - 1) / (64 * CFAR_BLOCK_WORDS));
+        handle->sorted = ifx_mem_alloc(size * sizeof(cfar_rank_t));
+        handle->rank = ifx_mem_alloc(size * sizeof(uint32_t));
+        handle->bitmap = ifx_mem_alloc((size_t)handle->num_blocks * CFAR_BLOCK_WORDS * sizeof(uint64_t));
+        handle->block_count = ifx_mem_alloc(handle->num_blocks * sizeof(uint32_t));
+        ok = handle->threshold && handle->sorted && handle->rank && handle->bitmap && handle->block_count;
+    }
+    else
+    {
+        handle->table = ifx_mem_alloc(((size_t)config->num_rows + 1) * ((size_t)config->num_cols + 1) * sizeof(double));
+        ok = handle->threshold && handle->table;
+    }
+
+    if (!ok)
+    {
+        ifx_cfar_destroy(handle);
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return NULL;
+    }
+
+    return handle;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_cfar_destroy(ifx_CFAR_t* handle)
+{
+    if (handle == NULL)
+        return;
+
+    ifx_mem_aligned_free(handle->threshold);
+    ifx_mem_free(handle->table);
+    ifx_mem_free(handle->sorted);
+    ifx_mem_free(handle->rank);
+    ifx_mem_free(handle->bitmap);
+    ifx_mem_free(handle->block_count);
+    ifx_mem_free(handle);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_cfar_threshold_vec(ifx_CFAR_t* handle,
+                            const ifx_Vector_R_t* input,
+                            ifx_Vector_R_t* threshold)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_VEC_BRK_VALID(input);
+    IFX_VEC_BRK_VALID(threshold);
+    IFX_ERR_BRK_COND((vLen(input) != handle->num_cols) || (vLen(threshold) != handle->num_cols),
+                     IFX_ERROR_DIMENSION_MISMATCH);
+
+    const cfar_map_t map = { vDat(input), 0, vStride(input), 1, (int32_t)vLen(input), 0, 0 };
+    compute_threshold(handle, &map);
+
+    for (uint32_t i = 0; i < vLen(threshold); i++)
+        vAt(threshold, i) = handle->threshold[i];
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_cfar_threshold_mat(ifx_CFAR_t* handle,
+                            const ifx_Matrix_R_t* input,
+                            ifx_Matrix_R_t* threshold)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_MAT_BRK_VALID(input);
+    IFX_MAT_BRK_VALID(threshold);
+    IFX_ERR_BRK_COND((mRows(input) != handle->num_rows) || (mCols(input) != handle->num_cols),
+                     IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_MAT_BRK_DIM(input, threshold);
+
+    const cfar_map_t map = { mDat(input), mLda(input), 1, (int32_t)mRows(input), (int32_t)mCols(input),
+                             handle->guard_rows, handle->training_rows };
+    compute_threshold(handle, &map);
+
+    for (uint32_t r = 0; r < mRows(threshold); r++)
+        memcpy(&mAt(threshold, r, 0), handle->threshold + (size_t)r * handle->num_cols,
+               handle->num_cols * sizeof(ifx_Float_t));
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_cfar_detect_vec(ifx_CFAR_t* handle,
+                             const ifx_Vector_R_t* input,
+                             uint32_t max_detections,
+                             uint32_t* detections)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+    IFX_VEC_BRV_VALID(input, 0);
+    IFX_ERR_BRV_COND(vLen(input) != handle->num_cols, IFX_ERROR_DIMENSION_MISMATCH, 0);
+    IFX_ERR_BRV_NULL(detections, 0);
+
+    const cfar_map_t map = { vDat(input), 0, vStride(input), 1, (int32_t)vLen(input), 0, 0 };
+    compute_threshold(handle, &map);
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; (i < vLen(input)) && (count < max_detections); i++)
+    {
+        if (vAt(input, i) > handle->threshold[i])
+            detections[count++] = i;
+    }
+
+    return count;
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_cfar_detect_mat(ifx_CFAR_t* handle,
+                             const ifx_Matrix_R_t* input,
+                             uint32_t max_detections,
+                             ifx_CFAR_Detection_t* detections)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+    IFX_MAT_BRV_VALID(input, 0);
+    IFX_ERR_BRV_COND((mRows(input) != handle->num_rows) || (mCols(input) != handle->num_cols),
+                     IFX_ERROR_DIMENSION_MISMATCH, 0);
+    IFX_ERR_BRV_NULL(detections, 0);
+
+    const cfar_map_t map = { mDat(input), mLda(input), 1, (int32_t)mRows(input), (int32_t)mCols(input),
+                             handle->guard_rows, handle->training_rows };
+    compute_threshold(handle, &map);
+
+    uint32_t count = 0;
+    for (uint32_t r = 0; r < mRows(input); r++)
+    {
+        const ifx_Float_t* threshold = handle->threshold + (size_t)r * handle->num_cols;
+
+        for (uint32_t c = 0; (c < mCols(input)) && (count < max_detections); c++)
+        {
+            if (mAt(input, r, c) > threshold[c])
+            {
+                detections[count].row = r;
+                detections[count].col = c;
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
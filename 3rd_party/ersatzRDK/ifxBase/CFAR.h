@@ -0,0 +1,240 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file CFAR.h
+ *
+ * \brief \copybrief gr_cfar
+ *
+ * For details refer to \ref gr_cfar
+ */
+
+#ifndef IFX_BASE_CFAR_H
+#define IFX_BASE_CFAR_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Defines.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Types.h"
+#include "ifxBase/Vector.h"
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Defines how the noise level is estimated from the training cells.
+ */
+typedef enum
+{
+    IFX_CFAR_CA = 0U,   /**< Cell averaging, mean of all training cells */
+    IFX_CFAR_GO = 1U,   /**< Greatest of the means of the leading and lagging training cells */
+    IFX_CFAR_SO = 2U,   /**< Smallest of the means of the leading and lagging training cells */
+    IFX_CFAR_OS = 3U,   /**< Ordered statistic, the training cell of a given rank */
+} ifx_CFAR_Type_t;
+
+/**
+ * @brief Configuration of a CFAR detector.
+ *
+ * The window around the cell under test consists of guard cells next to it
+ * and training cells beyond them, the counts are given per side. For
+ * vectors only the column parameters are used.
+ */
+typedef struct
+{
+    ifx_CFAR_Type_t type;           /**< Noise estimate */
+    uint32_t num_rows;              /**< Rows of the input maps, 1 if only vectors are used */
+    uint32_t num_cols;              /**< Columns of the input maps, length of the input vectors */
+    uint32_t guard_cols;            /**< Guard cells left and right of the cell under test */
+    uint32_t training_cols;         /**< Training cells left and right beyond the guard cells */
+    uint32_t guard_rows;            /**< Guard cells above and below the cell under test */
+    uint32_t training_rows;         /**< Training cells above and below beyond the guard cells */
+    ifx_Float_t threshold_factor;   /**< Detection threshold relative to the noise estimate */
+    uint32_t os_rank;               /**< \ref IFX_CFAR_OS only: rank (1 for the smallest) of the
+                                         noise estimate among the training cells of a complete
+                                         window, 0 for three quarters of them */
+} ifx_CFAR_Config_t;
+
+/**
+ * @brief Position of a detected cell.
+ */
+typedef struct
+{
+    uint32_t row;   /**< Row of the cell */
+    uint32_t col;   /**< Column of the cell */
+} ifx_CFAR_Detection_t;
+
+/**
+ * @brief Forward declaration structure for a CFAR detector.
+ */
+typedef struct ifx_CFAR_s ifx_CFAR_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_SDK_base
+  * @{
+  */
+
+/** @defgroup gr_cfar CFAR
+  * @brief API for constant false alarm rate detection
+  *
+  * A cell is detected if its value exceeds threshold_factor times the noise
+  * level estimated from the training cells around it. Inputs are power or
+  * magnitude values of range spectra (vectors) or range-Doppler maps
+  * (matrices). Near the borders the window is clipped to the input and the
+  * estimate uses the training cells which remain; cells without any
+  * training cell are never detected.
+  *
+  * The cell averaging variants take the sums of the training cells from a
+  * summed area table of the input, so each cell costs a constant number of
+  * operations independent of the window size. For the GO and SO variants on
+  * matrices the window is split at the column of the cell under test, the
+  * training cells in that column count towards both halves.
+  *
+  * OS-CFAR ranks all input values once and keeps the training cells of the
+  * sliding window as a bitmap over these ranks with bit counts per block.
+  * Moving the window by one cell only sets and clears the bits of the cells
+  * entering and leaving it, the noise estimate is found by counting bits
+  * instead of sorting the window. Clipped windows use the rank scaled to the
+  * number of remaining training cells.
+  *
+  * All memory is allocated when the detector is created.
+  *
+  * @{
+  */
+
+/**
+ * @brief Creates a CFAR detector.
+ *
+ * @param [in]     config    Configuration.
+ *
+ * @return Handle to the detector, NULL in case of an error.
+ */
+IFX_DLL_PUBLIC
+ifx_CFAR_t* ifx_cfar_create(const ifx_CFAR_Config_t* config);
+
+/**
+ * @brief Destroys a CFAR detector.
+ *
+ * @param [in]     handle    Detector to destroy, may be NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_cfar_destroy(ifx_CFAR_t* handle);
+
+/**
+ * @brief Computes the detection threshold of every cell of a vector.
+ *
+ * @param [in]     handle    Detector.
+ * @param [in]     input     Vector with num_cols values.
+ * @param [out]    threshold Vector with num_cols values.
+ */
+IFX_DLL_PUBLIC
+void ifx_cfar_threshold_vec(ifx_CFAR_t* handle,
+                            const ifx_Vector_R_t* input,
+                            ifx_Vector_R_t* threshold);
+
+/**
+ * @brief Computes the detection threshold of every cell of a matrix.
+ *
+ * @param [in]     handle    Detector.
+ * @param [in]     input     Matrix with num_rows rows and num_cols columns.
+ * @param [out]    threshold Matrix with num_rows rows and num_cols columns.
+ */
+IFX_DLL_PUBLIC
+void ifx_cfar_threshold_mat(ifx_CFAR_t* handle,
+                            const ifx_Matrix_R_t* input,
+                            ifx_Matrix_R_t* threshold);
+
+/**
+ * @brief Detects the cells of a vector exceeding their threshold.
+ *
+ * @param [in]     handle         Detector.
+ * @param [in]     input          Vector with num_cols values.
+ * @param [in]     max_detections Capacity of detections.
+ * @param [out]    detections     Indices of the detected cells in ascending order.
+ *
+ * @return Number of detected cells, at most max_detections.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_cfar_detect_vec(ifx_CFAR_t* handle,
+                             const ifx_Vector_R_t* input,
+                             uint32_t max_detections,
+                             uint32_t* detections);
+
+/**
+ * @brief Detects the cells of a matrix exceeding their threshold.
+ *
+ * @param [in]     handle         Detector.
+ * @param [in]     input          Matrix with num_rows rows and num_cols columns.
+ * @param [in]     max_detections Capacity of detections.
+ * @param [out]    detections     Detected cells in row major order.
+ *
+ * @return Number of detected cells, at most max_detections.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_cfar_detect_mat(ifx_CFAR_t* handle,
+                             const ifx_Matrix_R_t* input,
+                             uint32_t max_detections,
+                             ifx_CFAR_Detection_t* detections);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif /* IFX_BASE_CFAR_H */
@@ -0,0 +1,712 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "ifxBase/FFT.h"
+#include "ifxBase/Complex.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Mem.h"
+#include "ifxBase/internal/Macros.h"
+#include "ifxBase/internal/Simd.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/* Number of transforms computed together. The work arrays hold element n
+ * of all transforms of a block in FFT_LANES consecutive floats, so every
+ * butterfly is applied to FFT_LANES / 4 SIMD vectors at once. */
+#define FFT_LANES 8
+
+#define FFT_MAX_STAGES 32
+
+#define FFT_PI 3.14159265358979323846
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Plan of a transform. The complex transform of size cfft_size is
+ *        computed with Stockham autosort stages, a radix-2 stage first if
+ *        the size is not a power of 4, radix-4 stages otherwise. A real
+ *        transform of size fft_size packs even and odd samples into a
+ *        complex transform of half the size and separates the result in a
+ *        final pass.
+ */
+struct ifx_FFT_s
+{
+    ifx_FFT_Type_t type;
+    uint32_t fft_size;
+    uint32_t cfft_size;
+
+    uint32_t num_stages;
+    uint8_t radix[FFT_MAX_STAGES];
+    size_t twiddle_offset[FFT_MAX_STAGES];
+    ifx_Float_t* twiddles;      /**< Per stage and butterfly W^p, W^2p, W^3p as re, im pairs */
+    ifx_Float_t* split_twiddles;/**< W_N^k for k = 0..fft_size/2 of real transforms */
+
+    ifx_Float_t* window;        /**< Input window, NULL if none is set */
+    uint32_t window_len;
+
+    /** Two ping-pong buffers with real and imaginary parts of
+     *  cfft_size + 1 elements of FFT_LANES transforms each */
+    ifx_Float_t* work;
+    size_t work_stride;
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static void stage_radix2(uint32_t n, uint32_t s, const ifx_Float_t* tw,
+                         const float* xr, const float* xi, float* yr, float* yi);
+
+static void stage_radix4(uint32_t n, uint32_t s, const ifx_Float_t* tw,
+                         const float* xr, const float* xi, float* yr, float* yi);
+
+static uint32_t run_stages(const ifx_FFT_t* handle);
+
+static uint32_t split_real(const ifx_FFT_t* handle, uint32_t in, uint32_t num_bins);
+
+static void gather_real(const ifx_FFT_t* handle, const ifx_Float_t* src, uint32_t len,
+                        size_t elem_stride, size_t batch_stride, uint32_t count);
+
+static void gather_complex(const ifx_FFT_t* handle, const ifx_Complex_t* src, uint32_t len,
+                           size_t elem_stride, size_t batch_stride, uint32_t count);
+
+static void scatter(const ifx_FFT_t* handle, uint32_t buffer, uint32_t num_computed,
+                    ifx_Complex_t* dst, uint32_t len,
+                    size_t elem_stride, size_t batch_stride, uint32_t count);
+
+static void run_block_rc(ifx_FFT_t* handle,
+                         const ifx_Float_t* src, uint32_t in_len, size_t in_elem_stride, size_t in_batch_stride,
+                         ifx_Complex_t* dst, uint32_t out_len, size_t out_elem_stride, size_t out_batch_stride,
+                         uint32_t count);
+
+static void run_block_c(ifx_FFT_t* handle,
+                        const ifx_Complex_t* src, uint32_t in_len, size_t in_elem_stride, size_t in_batch_stride,
+                        ifx_Complex_t* dst, uint32_t out_len, size_t out_elem_stride, size_t out_batch_stride,
+                        uint32_t count);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static inline float* work_re(const ifx_FFT_t* handle, uint32_t buffer)
+{
+    return handle->work + 2 * buffer * handle->work_stride;
+}
+
+static inline float* work_im(const ifx_FFT_t* handle, uint32_t buffer)
+{
+    return handle->work + (2 * buffer + 1) * handle->work_stride;
+}
+
+//----------------------------------------------------------------------------
+
+static inline void cmul(v4_t ar, v4_t ai, v4_t wr, v4_t wi, v4_t* yr, v4_t* yi)
+{
+    *yr = v4_sub(v4_mul(ar, wr), v4_mul(ai, wi));
+    *yi = v4_add(v4_mul(ar, wi), v4_mul(ai, wr));
+}
+
+//----------------------------------------------------------------------------
+
+/* One Stockham stage of length n and stride s: element q + s * (p + k * m)
+ * of x feeds element q + s * (2 * p + k) of y */
+static void stage_radix2(uint32_t n, uint32_t s, const ifx_Float_t* tw,
+                         const float* xr, const float* xi, float* yr, float* yi)
+{
+    const uint32_t m = n / 2;
+    const size_t group = (size_t)s * FFT_LANES;
+
+    for (uint32_t p = 0; p < m; p++)
+    {
+        const v4_t wr = v4_set1(tw[2 * p]);
+        const v4_t wi = v4_set1(tw[2 * p + 1]);
+        const size_t ia = p * group;
+        const size_t ib = (p + m) * group;
+        const size_t iy = 2 * p * group;
+
+        for (size_t i = 0; i < group; i += 4)
+        {
+            const v4_t ar = v4_load(xr + ia + i), ai = v4_load(xi + ia + i);
+            const v4_t br = v4_load(xr + ib + i), bi = v4_load(xi + ib + i);
+            v4_t y1r, y1i;
+
+            cmul(v4_sub(ar, br), v4_sub(ai, bi), wr, wi, &y1r, &y1i);
+            v4_store(yr + iy + i, v4_add(ar, br));
+            v4_store(yi + iy + i, v4_add(ai, bi));
+            v4_store(yr + iy + group + i, y1r);
+            v4_store(yi + iy + group + i, y1i);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void stage_radix4(uint32_t n, uint32_t s, const ifx_Float_t* tw,
+                         const float* xr, const float* xi, float* yr, float* yi)
+{
+    const uint32_t m = n / 4;
+    const size_t group = (size_t)s * FFT_LANES;
+
+    for (uint32_t p = 0; p < m; p++)
+    {
+        const v4_t w1r = v4_set1(tw[6 * p + 0]), w1i = v4_set1(tw[6 * p + 1]);
+        const v4_t w2r = v4_set1(tw[6 * p + 2]), w2i = v4_set1(tw[6 * p + 3]);
+        const v4_t w3r = v4_set1(tw[6 * p + 4]), w3i = v4_set1(tw[6 * p + 5]);
+        const float* a_r = xr + p * group;
+        const float* a_i = xi + p * group;
+        const size_t step = m * group;
+        float* y_r = yr + 4 * p * group;
+        float* y_i = yi + 4 * p * group;
+
+        for (size_t i = 0; i < group; i += 4)
+        {
+            const v4_t ar = v4_load(a_r + i), ai = v4_load(a_i + i);
+            const v4_t br = v4_load(a_r + step + i), bi = v4_load(a_i + step + i);
+            const v4_t cr = v4_load(a_r + 2 * step + i), ci = v4_load(a_i + 2 * step + i);
+            const v4_t dr = v4_load(a_r + 3 * step + i), di = v4_load(a_i + 3 * step + i);
+
+            const v4_t apc_r = v4_add(ar, cr), apc_i = v4_add(ai, ci);
+            const v4_t amc_r = v4_sub(ar, cr), amc_i = v4_sub(ai, ci);
+            const v4_t bpd_r = v4_add(br, dr), bpd_i = v4_add(bi, di);
+            // i * (b - d)
+            const v4_t jbmd_r = v4_sub(di, bi), jbmd_i = v4_sub(br, dr);
+            v4_t t_r, t_i;
+
+            v4_store(y_r + i, v4_add(apc_r, bpd_r));
+            v4_store(y_i + i, v4_add(apc_i, bpd_i));
+
+            cmul(v4_sub(amc_r, jbmd_r), v4_sub(amc_i, jbmd_i), w1r, w1i, &t_r, &t_i);
+            v4_store(y_r + group + i, t_r);
+            v4_store(y_i + group + i, t_i);
+
+            cmul(v4_sub(apc_r, bpd_r), v4_sub(apc_i, bpd_i), w2r, w2i, &t_r, &t_i);
+            v4_store(y_r + 2 * group + i, t_r);
+            v4_store(y_i + 2 * group + i, t_i);
+
+            cmul(v4_add(amc_r, jbmd_r), v4_add(amc_i, jbmd_i), w3r, w3i, &t_r, &t_i);
+            v4_store(y_r + 3 * group + i, t_r);
+            v4_store(y_i + 3 * group + i, t_i);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/* Runs the complex transform on work buffer 0 and returns the buffer
+ * holding the result */
+static uint32_t run_stages(const ifx_FFT_t* handle)
+{
+    uint32_t n = handle->cfft_size;
+    uint32_t s = 1;
+    uint32_t in = 0;
+
+    for (uint32_t stage = 0; stage < handle->num_stages; stage++)
+    {
+        const ifx_Float_t* tw = handle->twiddles + handle->twiddle_offset[stage];
+
+        if (handle->radix[stage] == 4)
+            stage_radix4(n, s, tw, work_re(handle, in), work_im(handle, in),
+                         work_re(handle, 1 - in), work_im(handle, 1 - in));
+        else
+            stage_radix2(n, s, tw, work_re(handle, in), work_im(handle, in),
+                         work_re(handle, 1 - in), work_im(handle, 1 - in));
+
+        n /= handle->radix[stage];
+        s *= handle->radix[stage];
+        in = 1 - in;
+    }
+
+    return in;
+}
+
+//----------------------------------------------------------------------------
+
+/* Computes bins 0..num_bins-1 (at most fft_size/2+1) of the real transform
+ * from the half size complex transform z of the even and odd samples:
+ * X[k] = (Z[k] + conj(Z[M-k])) / 2 - i * W^k * (Z[k] - conj(Z[M-k])) / 2 */
+static uint32_t split_real(const ifx_FFT_t* handle, uint32_t in, uint32_t num_bins)
+{
+    const uint32_t M = handle->cfft_size;
+    const float* zr = work_re(handle, in);
+    const float* zi = work_im(handle, in);
+    float* xr = work_re(handle, 1 - in);
+    float* xi = work_im(handle, 1 - in);
+    const v4_t half = v4_set1(0.5f);
+
+    for (uint32_t k = 0; k < num_bins; k++)
+    {
+        const size_t a = (size_t)(k % M) * FFT_LANES;
+        const size_t b = (size_t)((M - k) % M) * FFT_LANES;
+        const v4_t wr = v4_set1(handle->split_twiddles[2 * k]);
+        const v4_t wi = v4_set1(handle->split_twiddles[2 * k + 1]);
+
+        for (uint32_t j = 0; j < FFT_LANES; j += 4)
+        {
+            const v4_t zar = v4_load(zr + a + j), zai = v4_load(zi + a + j);
+            const v4_t zbr = v4_load(zr + b + j), zbi = v4_load(zi + b + j);
+
+            const v4_t er = v4_mul(half, v4_add(zar, zbr));
+            const v4_t ei = v4_mul(half, v4_sub(zai, zbi));
+            // o = -i * (Z[k] - conj(Z[M-k])) / 2
+            const v4_t or_ = v4_mul(half, v4_add(zai, zbi));
+            const v4_t oi = v4_mul(half, v4_sub(zbr, zar));
+            v4_t tr, ti;
+
+            cmul(or_, oi, wr, wi, &tr, &ti);
+            v4_store(xr + (size_t)k * FFT_LANES + j, v4_add(er, tr));
+            v4_store(xi + (size_t)k * FFT_LANES + j, v4_add(ei, ti));
+        }
+    }
+
+    return 1 - in;
+}
+
+//----------------------------------------------------------------------------
+
+/* Loads count (at most FFT_LANES) real inputs of len values into work
+ * buffer 0 as complex values of even and odd samples and applies the
+ * window. Value n of input j is src[n * elem_stride + j * batch_stride]. */
+static void gather_real(const ifx_FFT_t* handle, const ifx_Float_t* src, uint32_t len,
+                        size_t elem_stride, size_t batch_stride, uint32_t count)
+{
+    float* re = work_re(handle, 0);
+    float* im = work_im(handle, 0);
+    const ifx_Float_t* window = handle->window;
+
+    if (window && (len > handle->window_len))
+        len = handle->window_len;
+
+    for (uint32_t n = 0; n < handle->fft_size; n++)
+    {
+        float* dst = ((n & 1) ? im : re) + (size_t)(n / 2) * FFT_LANES;
+        const ifx_Float_t* s = src + n * elem_stride;
+
+        if (n >= len)
+        {
+            memset(dst, 0, FFT_LANES * sizeof(float));
+        }
+        else if (window)
+        {
+            const ifx_Float_t w = window[n];
+            uint32_t j = 0;
+            for (; j < count; j++)
+                dst[j] = s[j * batch_stride] * w;
+            for (; j < FFT_LANES; j++)
+                dst[j] = 0;
+        }
+        else if ((batch_stride == 1) && (count == FFT_LANES))
+        {
+            memcpy(dst, s, FFT_LANES * sizeof(float));
+        }
+        else
+        {
+            uint32_t j = 0;
+            for (; j < count; j++)
+                dst[j] = s[j * batch_stride];
+            for (; j < FFT_LANES; j++)
+                dst[j] = 0;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void gather_complex(const ifx_FFT_t* handle, const ifx_Complex_t* src, uint32_t len,
+                           size_t elem_stride, size_t batch_stride, uint32_t count)
+{
+    float* re = work_re(handle, 0);
+    float* im = work_im(handle, 0);
+
+    if (handle->window && (len > handle->window_len))
+        len = handle->window_len;
+
+    for (uint32_t n = 0; n < handle->fft_size; n++)
+    {
+        float* dst_re = re + (size_t)n * FFT_LANES;
+        float* dst_im = im + (size_t)n * FFT_LANES;
+        const ifx_Complex_t* s = src + n * elem_stride;
+        uint32_t j = 0;
+
+        if (n < len)
+        {
+            const ifx_Float_t w = handle->window ? handle->window[n] : 1;
+            for (; j < count; j++)
+            {
+                dst_re[j] = IFX_COMPLEX_REAL(s[j * batch_stride]) * w;
+                dst_im[j] = IFX_COMPLEX_IMAG(s[j * batch_stride]) * w;
+            }
+        }
+
+        for (; j < FFT_LANES; j++)
+        {
+            dst_re[j] = 0;
+            dst_im[j] = 0;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/* Stores len bins of count transforms from the given work buffer, bins
+ * beyond num_computed are taken from the conjugate symmetric half */
+static void scatter(const ifx_FFT_t* handle, uint32_t buffer, uint32_t num_computed,
+                    ifx_Complex_t* dst, uint32_t len,
+                    size_t elem_stride, size_t batch_stride, uint32_t count)
+{
+    const float* re = work_re(handle, buffer);
+    const float* im = work_im(handle, buffer);
+
+    for (uint32_t k = 0; k < len; k++)
+    {
+        const bool mirrored = (k >= num_computed);
+        const size_t src = (size_t)(mirrored ? handle->fft_size - k : k) * FFT_LANES;
+        ifx_Complex_t* d = dst + k * elem_stride;
+
+        if (!mirrored && (batch_stride == 1) && (count == FFT_LANES))
+        {
+            for (uint32_t j = 0; j < FFT_LANES; j += 4)
+                v4_store_interleaved((float*)(d + j), v4_load(re + src + j), v4_load(im + src + j));
+        }
+        else
+        {
+            for (uint32_t j = 0; j < count; j++)
+            {
+                IFX_COMPLEX_SET(d[j * batch_stride], re[src + j],
+                                mirrored ? -im[src + j] : im[src + j]);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void run_block_rc(ifx_FFT_t* handle,
+                         const ifx_Float_t* src, uint32_t in_len, size_t in_elem_stride, size_t in_batch_stride,
+                         ifx_Complex_t* dst, uint32_t out_len, size_t out_elem_stride, size_t out_batch_stride,
+                         uint32_t count)
+{
+    const uint32_t half = handle->fft_size / 2;
+    const uint32_t num_bins = (out_len < half + 1) ? out_len : half + 1;
+
+    gather_real(handle, src, in_len, in_elem_stride, in_batch_stride, count);
+    uint32_t buffer = run_stages(handle);
+    buffer = split_real(handle, buffer, num_bins);
+    scatter(handle, buffer, num_bins, dst, out_len, out_elem_stride, out_batch_stride, count);
+}
+
+//----------------------------------------------------------------------------
+
+static void run_block_c(ifx_FFT_t* handle,
+                        const ifx_Complex_t* src, uint32_t in_len, size_t in_elem_stride, size_t in_batch_stride,
+                        ifx_Complex_t* dst, uint32_t out_len, size_t out_elem_stride, size_t out_batch_stride,
+                        uint32_t count)
+{
+    gather_complex(handle, src, in_len, in_elem_stride, in_batch_stride, count);
+    const uint32_t buffer = run_stages(handle);
+    scatter(handle, buffer, handle->fft_size, dst, out_len, out_elem_stride, out_batch_stride, count);
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_FFT_t* ifx_fft_create(ifx_FFT_Type_t fft_type,
+                          uint32_t fft_size)
+{
+    IFX_ERR_BRN_ARGUMENT((fft_type != IFX_FFT_TYPE_R2C) && (fft_type != IFX_FFT_TYPE_C2C));
+    IFX_ERR_BRN_ARGUMENT((fft_size == 0) || ((fft_size & (fft_size - 1)) != 0));
+    IFX_ERR_BRN_ARGUMENT((fft_type == IFX_FFT_TYPE_R2C) && (fft_size < 2));
+    IFX_ERR_BRN_ARGUMENT(fft_size > (1u << 24));
+
+    ifx_FFT_t* handle = ifx_mem_calloc(1, sizeof(ifx_FFT_t));
+    IFX_ERR_BRN_MEMALLOC(handle);
+
+    handle->type = fft_type;
+    handle->fft_size = fft_size;
+    handle->cfft_size = (fft_type == IFX_FFT_TYPE_R2C) ? fft_size / 2 : fft_size;
+
+    // a radix-2 stage first if needed, radix-4 for the rest
+    uint32_t log2_size = 0;
+    while ((1u << log2_size) < handle->cfft_size)
+        log2_size++;
+
+    uint32_t n = handle->cfft_size;
+    size_t num_twiddles = 0;
+    if (log2_size & 1)
+    {
+        handle->radix[handle->num_stages] = 2;
+        handle->twiddle_offset[handle->num_stages++] = num_twiddles;
+        num_twiddles += 2 * (size_t)(n / 2);
+        n /= 2;
+    }
+    while (n > 1)
+    {
+        handle->radix[handle->num_stages] = 4;
+        handle->twiddle_offset[handle->num_stages++] = num_twiddles;
+        num_twiddles += 6 * (size_t)(n / 4);
+        n /= 4;
+    }
+
+    const size_t num_split_twiddles = (fft_type == IFX_FFT_TYPE_R2C) ? 2 * ((size_t)fft_size / 2 + 1) : 0;
+    handle->work_stride = ((size_t)handle->cfft_size + 1) * FFT_LANES;
+
+    handle->twiddles = ifx_mem_aligned_alloc((num_twiddles + num_split_twiddles + 1) * sizeof(ifx_Float_t), MEMORY_ALIGNMENT);
+    handle->work = ifx_mem_aligned_alloc(4 * handle->work_stride * sizeof(ifx_Float_t), MEMORY_ALIGNMENT);
+    if (!handle->twiddles || !handle->work)
+    {
+        ifx_fft_destroy(handle);
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return NULL;
+    }
+    handle->split_twiddles = handle->twiddles + num_twiddles;
+
+    n = handle->cfft_size;
+    for (uint32_t stage = 0; stage < handle->num_stages; stage++)
+    {
+        const uint32_t radix = handle->radix[stage];
+        ifx_Float_t* tw = handle->twiddles + handle->twiddle_offset[stage];
+
+        for (uint32_t p = 0; p < n / radix; p++)
+        {
+            for (uint32_t r = 1; r < radix; r++)
+            {
+                const double angle = -2.0 * FFT_PI * (double)(r * p) / (double)n;
+                *tw++ = (ifx_Float_t)cos(angle);
+                *tw++ = (ifx_Float_t)sin(angle);
+            }
+        }
+        n /= radix;
+    }
+
+    for (size_t k = 0; k < num_split_twiddles / 2; k++)
+    {
+        const double angle = -2.0 * FFT_PI * (double)k / (double)fft_size;
+        handle->split_twiddles[2 * k] = (ifx_Float_t)cos(angle);
+        handle->split_twiddles[2 * k + 1] = (ifx_Float_t)sin(angle);
+    }
+
+    return handle;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_destroy(ifx_FFT_t* handle)
+{
+    if (handle == NULL)
+        return;
+
+    ifx_mem_aligned_free(handle->twiddles);
+    ifx_mem_aligned_free(handle->work);
+    ifx_mem_aligned_free(handle->window);
+    ifx_mem_free(handle);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_FFT_Type_t ifx_fft_get_fft_type(const ifx_FFT_t* handle)
+{
+    IFX_ERR_BRV_NULL(handle, IFX_FFT_TYPE_R2C);
+
+    return handle->type;
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_fft_get_fft_size(const ifx_FFT_t* handle)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+
+    return handle->fft_size;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_set_window(ifx_FFT_t* handle,
+                        const ifx_Vector_R_t* window)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    if (window == NULL)
+    {
+        handle->window_len = 0;
+        ifx_mem_aligned_free(handle->window);
+        handle->window = NULL;
+        return;
+    }
+
+    IFX_VEC_BRK_VALID(window);
+    IFX_ERR_BRK_COND(vLen(window) > handle->fft_size, IFX_ERROR_DIMENSION_MISMATCH);
+
+    if (handle->window == NULL)
+    {
+        handle->window = ifx_mem_aligned_alloc(handle->fft_size * sizeof(ifx_Float_t), MEMORY_ALIGNMENT);
+        IFX_ERR_BRK_MEMALLOC(handle->window);
+    }
+
+    for (uint32_t n = 0; n < vLen(window); n++)
+        handle->window[n] = vAt(window, n);
+    handle->window_len = vLen(window);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_run_rc(ifx_FFT_t* handle,
+                    const ifx_Vector_R_t* input,
+                    ifx_Vector_C_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_VEC_BRK_VALID(input);
+    IFX_VEC_BRK_VALID(output);
+    IFX_ERR_BRK_ARGUMENT(handle->type != IFX_FFT_TYPE_R2C);
+    IFX_ERR_BRK_COND(vLen(input) > handle->fft_size, IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(vLen(output) > handle->fft_size, IFX_ERROR_DIMENSION_MISMATCH);
+
+    run_block_rc(handle, vDat(input), vLen(input), vStride(input), 0,
+                 vDat(output), vLen(output), vStride(output), 0, 1);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_run_c(ifx_FFT_t* handle,
+                   const ifx_Vector_C_t* input,
+                   ifx_Vector_C_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_VEC_BRK_VALID(input);
+    IFX_VEC_BRK_VALID(output);
+    IFX_ERR_BRK_ARGUMENT(handle->type != IFX_FFT_TYPE_C2C);
+    IFX_ERR_BRK_COND(vLen(input) > handle->fft_size, IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(vLen(output) > handle->fft_size, IFX_ERROR_DIMENSION_MISMATCH);
+
+    run_block_c(handle, vDat(input), vLen(input), vStride(input), 0,
+                vDat(output), vLen(output), vStride(output), 0, 1);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_run_rc_rows(ifx_FFT_t* handle,
+                         const ifx_Matrix_R_t* input,
+                         ifx_Matrix_C_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_MAT_BRK_VALID(input);
+    IFX_MAT_BRK_VALID(output);
+    IFX_ERR_BRK_ARGUMENT(handle->type != IFX_FFT_TYPE_R2C);
+    IFX_MAT_BRK_DIM_ROW(input, output);
+    IFX_ERR_BRK_COND(mCols(input) > handle->fft_size, IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(mCols(output) > handle->fft_size, IFX_ERROR_DIMENSION_MISMATCH);
+
+    for (uint32_t r = 0; r < mRows(input); r += FFT_LANES)
+    {
+        const uint32_t count = (mRows(input) - r < FFT_LANES) ? mRows(input) - r : FFT_LANES;
+
+        run_block_rc(handle, &mAt(input, r, 0), mCols(input), 1, mLda(input),
+                     &mAt(output, r, 0), mCols(output), 1, mLda(output), count);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_run_c_rows(ifx_FFT_t* handle,
+                        const ifx_Matrix_C_t* input,
+                        ifx_Matrix_C_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_MAT_BRK_VALID(input);
+    IFX_MAT_BRK_VALID(output);
+    IFX_ERR_BRK_ARGUMENT(handle->type != IFX_FFT_TYPE_C2C);
+    IFX_MAT_BRK_DIM_ROW(input, output);
+    IFX_ERR_BRK_COND(mCols(input) > handle->fft_size, IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(mCols(output) > handle->fft_size, IFX_ERROR_DIMENSION_MISMATCH);
+
+    for (uint32_t r = 0; r < mRows(input); r += FFT_LANES)
+    {
+        const uint32_t count = (mRows(input) - r < FFT_LANES) ? mRows(input) - r : FFT_LANES;
+
+        run_block_c(handle, &mAt(input, r, 0), mCols(input), 1, mLda(input),
+                    &mAt(output, r, 0), mCols(output), 1, mLda(output), count);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_run_rc_cube(ifx_FFT_t* handle,
+                         const ifx_Cube_R_t* input,
+                         ifx_Cube_C_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(input);
+    IFX_ERR_BRK_NULL(output);
+    IFX_ERR_BRK_ARGUMENT(handle->type != IFX_FFT_TYPE_R2C);
+    IFX_ERR_BRK_COND((cRows(input) != cRows(output)) || (cCols(input) != cCols(output)),
+                     IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(cSlices(input) > handle->fft_size, IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(cSlices(output) > handle->fft_size, IFX_ERROR_DIMENSION_MISMATCH);
+
+    // every element of a slice is a separate transform, neighbouring
+    // elements are contiguous so a block is loaded with plain vector loads
+    const size_t num_transforms = cSliceSize(input);
+
+    for (size_t t = 0; t < num_transforms; t += FFT_LANES)
+    {
+        const uint32_t count = (num_transforms - t < FFT_LANES) ? (uint32_t)(num_transforms - t) : FFT_LANES;
+
+        run_block_rc(handle, cDat(input) + t, cSlices(input), num_transforms, 1,
+                     cDat(output) + t, cSlices(output), num_transforms, 1, count);
+    }
+}
@@ -0,0 +1,247 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file FFT.h
+ *
+ * \brief \copybrief gr_fft
+ *
+ * For details refer to \ref gr_fft
+ */
+
+#ifndef IFX_BASE_FFT_H
+#define IFX_BASE_FFT_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Cube.h"
+#include "ifxBase/Defines.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Types.h"
+#include "ifxBase/Vector.h"
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Defines supported FFT types.
+ */
+typedef enum
+{
+    IFX_FFT_TYPE_R2C = 0U,  /**< Input is real, output is complex */
+    IFX_FFT_TYPE_C2C = 1U,  /**< Input and output are complex */
+} ifx_FFT_Type_t;
+
+/**
+ * @brief Forward declaration structure for an FFT plan.
+ */
+typedef struct ifx_FFT_s ifx_FFT_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_SDK_base
+  * @{
+  */
+
+/** @defgroup gr_fft FFT
+  * @brief API for Fast Fourier Transforms
+  *
+  * An FFT plan is created once for a transform type and size. Creating the
+  * plan precomputes the twiddle factors and allocates the scratch memory,
+  * running it doesn't allocate.
+  *
+  * The transform is a forward DFT without scaling,
+  * X[k] = sum_n x[n] * exp(-2*pi*i*k*n/fft_size). Inputs shorter than
+  * fft_size are zero padded. Outputs may be shorter than fft_size, only the
+  * first bins are computed then; for real inputs the first fft_size/2+1 bins
+  * hold all information.
+  *
+  * Transforms are computed in blocks of several inputs at once using SSE or
+  * NEON where available, so the batched functions (rows of a matrix, all
+  * rows and columns of a cube) are considerably faster than transforming
+  * vectors one by one.
+  *
+  * A plan holds scratch memory and must not be run from several threads at
+  * the same time.
+  *
+  * @{
+  */
+
+/**
+ * @brief Creates an FFT plan.
+ *
+ * @param [in]     fft_type  Type of the transform, see \ref ifx_FFT_Type_t.
+ * @param [in]     fft_size  Size of the transform, must be a power of 2
+ *                           (at least 2 for \ref IFX_FFT_TYPE_R2C).
+ *
+ * @return Handle to the plan, NULL in case of an error.
+ */
+IFX_DLL_PUBLIC
+ifx_FFT_t* ifx_fft_create(ifx_FFT_Type_t fft_type,
+                          uint32_t fft_size);
+
+/**
+ * @brief Destroys an FFT plan.
+ *
+ * @param [in]     handle    Plan to destroy, may be NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_destroy(ifx_FFT_t* handle);
+
+/**
+ * @brief Returns the type of the transform computed by the plan.
+ */
+IFX_DLL_PUBLIC
+ifx_FFT_Type_t ifx_fft_get_fft_type(const ifx_FFT_t* handle);
+
+/**
+ * @brief Returns the size of the transform computed by the plan.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_fft_get_fft_size(const ifx_FFT_t* handle);
+
+/**
+ * @brief Sets a window applied to the input of every transform.
+ *
+ * The window is multiplied into the input while it is loaded for the
+ * transform, which costs nothing compared to a separate pass over the data.
+ * Sample n of each input is weighted with window[n], samples past the end
+ * of the window are treated as 0. The coefficients are copied.
+ *
+ * @param [in]     handle    Plan of any type.
+ * @param [in]     window    Window of at most fft_size coefficients, e.g.
+ *                           from \ref ifx_window_get, NULL removes the window.
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_set_window(ifx_FFT_t* handle,
+                        const ifx_Vector_R_t* window);
+
+/**
+ * @brief Computes the FFT of a real vector.
+ *
+ * @param [in]     handle    Plan of type \ref IFX_FFT_TYPE_R2C.
+ * @param [in]     input     Input of at most fft_size values, zero padded to fft_size.
+ * @param [out]    output    First bins of the spectrum, at most fft_size values.
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_run_rc(ifx_FFT_t* handle,
+                    const ifx_Vector_R_t* input,
+                    ifx_Vector_C_t* output);
+
+/**
+ * @brief Computes the FFT of a complex vector.
+ *
+ * @param [in]     handle    Plan of type \ref IFX_FFT_TYPE_C2C.
+ * @param [in]     input     Input of at most fft_size values, zero padded to fft_size.
+ * @param [out]    output    First bins of the spectrum, at most fft_size values.
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_run_c(ifx_FFT_t* handle,
+                   const ifx_Vector_C_t* input,
+                   ifx_Vector_C_t* output);
+
+/**
+ * @brief Computes the FFT of every row of a real matrix.
+ *
+ * @param [in]     handle    Plan of type \ref IFX_FFT_TYPE_R2C.
+ * @param [in]     input     Matrix with rows of at most fft_size values.
+ * @param [out]    output    Matrix with the same number of rows and at most
+ *                           fft_size columns.
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_run_rc_rows(ifx_FFT_t* handle,
+                         const ifx_Matrix_R_t* input,
+                         ifx_Matrix_C_t* output);
+
+/**
+ * @brief Computes the FFT of every row of a complex matrix.
+ *
+ * @param [in]     handle    Plan of type \ref IFX_FFT_TYPE_C2C.
+ * @param [in]     input     Matrix with rows of at most fft_size values.
+ * @param [out]    output    Matrix with the same number of rows and at most
+ *                           fft_size columns.
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_run_c_rows(ifx_FFT_t* handle,
+                        const ifx_Matrix_C_t* input,
+                        ifx_Matrix_C_t* output);
+
+/**
+ * @brief Computes the FFT along the slices of a real cube.
+ *
+ * For radar frames with the layout [sample][antenna][chirp] this is the
+ * range FFT of every chirp of every antenna in one call. Input slice s of
+ * each row and column is sample s of the transform, output slice k holds
+ * bin k.
+ *
+ * @param [in]     handle    Plan of type \ref IFX_FFT_TYPE_R2C.
+ * @param [in]     input     Cube with at most fft_size slices.
+ * @param [out]    output    Cube with the rows and columns of the input and
+ *                           at most fft_size slices, typically fft_size/2.
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_run_rc_cube(ifx_FFT_t* handle,
+                         const ifx_Cube_R_t* input,
+                         ifx_Cube_C_t* output);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif /* IFX_BASE_FFT_H */
@@ -33,7 +33,10 @@
 ==============================================================================
 */
 
+#include <float.h>
+#include <math.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "ifxBase/LA.h"
 #include "ifxBase/Complex.h"
@@ -50,6 +53,10 @@
 ==============================================================================
 */
 
+/* Matrices up to this size are inverted and their determinants computed on
+ * the stack with fixed size kernels instead of the general LU decomposition */
+#define LA_SMALL_MAX 4
+
 /*
 ==============================================================================
    3. LOCAL TYPES
@@ -104,6 +111,80 @@ static void determinant_r_inplace(ifx_Matrix_R_t* A,
 static void determinant_c_inplace(ifx_Matrix_C_t* A,
                                   ifx_Complex_t* determinant);
 
+static inline ifx_Complex_t cmul(ifx_Complex_t a, ifx_Complex_t b);
+
+static inline ifx_Complex_t cadd(ifx_Complex_t a, ifx_Complex_t b);
+
+static inline ifx_Complex_t csub(ifx_Complex_t a, ifx_Complex_t b);
+
+/* Returns a*b - c*d, the determinant of a 2x2 matrix */
+static inline ifx_Complex_t cdet2(ifx_Complex_t a, ifx_Complex_t b, ifx_Complex_t c, ifx_Complex_t d);
+
+static inline ifx_Complex_t crecip(ifx_Complex_t z);
+
+static inline ifx_Float_t cnorm(ifx_Complex_t z);
+
+static inline bool cis_zero(ifx_Complex_t z);
+
+static inline ifx_Complex_t cdiv(ifx_Complex_t a, ifx_Complex_t b);
+
+/**
+ * @brief Computes inverse and determinant of a real 2x2 matrix in closed form
+ *
+ * The matrix m is stored row by row without padding, the inverse is written
+ * to r in the same layout unless the determinant is zero. The determinant
+ * is computed in double precision, where the products of two floats are
+ * exact, so linearly dependent rows give exactly zero in most cases.
+ *
+ * @param [in]     m         matrix
+ * @param [out]    r         inverse of m
+ * @return determinant of m
+ */
+static double invert2_r(const ifx_Float_t m[4], ifx_Float_t r[4]);
+
+static ifx_Complex_t invert2_c(const ifx_Complex_t m[4], ifx_Complex_t r[4]);
+
+/**
+ * @brief Computes inverse and determinant of a real matrix of size n up to
+ *        LA_SMALL_MAX by LU decomposition.
+ *
+ * Same elimination as lu_r_inplace and lu_invert_r, on a local copy stored
+ * row by row without padding. The pivot row is not scaled, so a row that
+ * duplicates another cancels exactly and yields a zero pivot.
+ *
+ * @param [in]     m         matrix
+ * @param [in]     n         size of the matrix
+ * @param [out]    r         inverse of m (might be NULL), not written if a
+ *                           pivot is zero
+ * @return determinant of m, 0 if a pivot is zero
+ */
+static double invert_lu_r(const ifx_Float_t* m, uint32_t n, ifx_Float_t* r);
+
+static ifx_Complex_t invert_lu_c(const ifx_Complex_t* m, uint32_t n, ifx_Complex_t* r);
+
+/**
+ * @brief Computes the determinant and, if inverse is not NULL and the
+ *        matrix is not singular, the inverse of a real matrix of size n up
+ *        to LA_SMALL_MAX using only stack memory.
+ *
+ * The matrix is considered singular if |det| <= n * FLT_EPSILON times the
+ * product of the row norms. The input may be the same memory as the inverse.
+ *
+ * @param [in]     a             first element of the matrix
+ * @param [in]     lda           distance of consecutive rows of a
+ * @param [in]     n             size of the matrix
+ * @param [out]    inverse       first element of the inverse (might be NULL)
+ * @param [in]     ldi           distance of consecutive rows of inverse
+ * @param [out]    determinant   determinant of the matrix (might be NULL)
+ * @retval true     if the matrix is invertible
+ * @retval false    if the matrix is singular
+ */
+static bool small_invert_r(const ifx_Float_t* a, size_t lda, uint32_t n,
+                           ifx_Float_t* inverse, size_t ldi, ifx_Float_t* determinant);
+
+static bool small_invert_c(const ifx_Complex_t* a, size_t lda, uint32_t n,
+                           ifx_Complex_t* inverse, size_t ldi, ifx_Complex_t* determinant);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
@@ -787,6 +868,386 @@ fail:
     }
 }
 
+//----------------------------------------------------------------------------
+
+static inline ifx_Complex_t cmul(ifx_Complex_t a, ifx_Complex_t b)
+{
+    const ifx_Complex_t r = IFX_COMPLEX_DEF(
+        IFX_COMPLEX_REAL(a) * IFX_COMPLEX_REAL(b) - IFX_COMPLEX_IMAG(a) * IFX_COMPLEX_IMAG(b),
+        IFX_COMPLEX_REAL(a) * IFX_COMPLEX_IMAG(b) + IFX_COMPLEX_IMAG(a) * IFX_COMPLEX_REAL(b));
+    return r;
+}
+
+//----------------------------------------------------------------------------
+
+static inline ifx_Complex_t cadd(ifx_Complex_t a, ifx_Complex_t b)
+{
+    const ifx_Complex_t r = IFX_COMPLEX_DEF(IFX_COMPLEX_REAL(a) + IFX_COMPLEX_REAL(b),
+                                            IFX_COMPLEX_IMAG(a) + IFX_COMPLEX_IMAG(b));
+    return r;
+}
+
+//----------------------------------------------------------------------------
+
+static inline ifx_Complex_t csub(ifx_Complex_t a, ifx_Complex_t b)
+{
+    const ifx_Complex_t r = IFX_COMPLEX_DEF(IFX_COMPLEX_REAL(a) - IFX_COMPLEX_REAL(b),
+                                            IFX_COMPLEX_IMAG(a) - IFX_COMPLEX_IMAG(b));
+    return r;
+}
+
+//----------------------------------------------------------------------------
+
+static inline ifx_Complex_t cdet2(ifx_Complex_t a, ifx_Complex_t b, ifx_Complex_t c, ifx_Complex_t d)
+{
+    return csub(cmul(a, b), cmul(c, d));
+}
+
+//----------------------------------------------------------------------------
+
+static inline ifx_Complex_t crecip(ifx_Complex_t z)
+{
+    const ifx_Float_t s = 1 / cnorm(z);
+    const ifx_Complex_t r = IFX_COMPLEX_DEF(IFX_COMPLEX_REAL(z) * s, -IFX_COMPLEX_IMAG(z) * s);
+    return r;
+}
+
+//----------------------------------------------------------------------------
+
+static inline ifx_Float_t cnorm(ifx_Complex_t z)
+{
+    return IFX_COMPLEX_REAL(z) * IFX_COMPLEX_REAL(z) + IFX_COMPLEX_IMAG(z) * IFX_COMPLEX_IMAG(z);
+}
+
+//----------------------------------------------------------------------------
+
+static inline bool cis_zero(ifx_Complex_t z)
+{
+    return (IFX_COMPLEX_REAL(z) == 0) && (IFX_COMPLEX_IMAG(z) == 0);
+}
+
+//----------------------------------------------------------------------------
+
+static inline ifx_Complex_t cdiv(ifx_Complex_t a, ifx_Complex_t b)
+{
+    // divides instead of multiplying with the reciprocal, so a / a is
+    // exactly 1 and duplicated rows cancel exactly
+    const ifx_Float_t n = cnorm(b);
+    const ifx_Complex_t b_conj = IFX_COMPLEX_DEF(IFX_COMPLEX_REAL(b), -IFX_COMPLEX_IMAG(b));
+    const ifx_Complex_t t = cmul(a, b_conj);
+    const ifx_Complex_t r = IFX_COMPLEX_DEF(IFX_COMPLEX_REAL(t) / n, IFX_COMPLEX_IMAG(t) / n);
+    return r;
+}
+
+//----------------------------------------------------------------------------
+
+static double invert2_r(const ifx_Float_t m[4], ifx_Float_t r[4])
+{
+    const double det = (double)m[0] * m[3] - (double)m[1] * m[2];
+
+    if (det != 0)
+    {
+        const double s = 1 / det;
+        r[0] = (ifx_Float_t)(m[3] * s);
+        r[1] = (ifx_Float_t)(-m[1] * s);
+        r[2] = (ifx_Float_t)(-m[2] * s);
+        r[3] = (ifx_Float_t)(m[0] * s);
+    }
+
+    return det;
+}
+
+//----------------------------------------------------------------------------
+
+static ifx_Complex_t invert2_c(const ifx_Complex_t m[4], ifx_Complex_t r[4])
+{
+    const ifx_Complex_t det = cdet2(m[0], m[3], m[1], m[2]);
+
+    if (!cis_zero(det))
+    {
+        const ifx_Complex_t s = crecip(det);
+        const ifx_Complex_t minus_s = IFX_COMPLEX_DEF(-IFX_COMPLEX_REAL(s), -IFX_COMPLEX_IMAG(s));
+        r[0] = cmul(m[3], s);
+        r[1] = cmul(m[1], minus_s);
+        r[2] = cmul(m[2], minus_s);
+        r[3] = cmul(m[0], s);
+    }
+
+    return det;
+}
+
+//----------------------------------------------------------------------------
+
+static double invert_lu_r(const ifx_Float_t* m, uint32_t n, ifx_Float_t* r)
+{
+    ifx_Float_t a[LA_SMALL_MAX * LA_SMALL_MAX];
+    uint32_t P[LA_SMALL_MAX];
+    double det = 1;
+
+    memcpy(a, m, sizeof(ifx_Float_t) * n * n);
+
+    for (uint32_t i = 0; i < n; i++)
+        P[i] = i;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        ifx_Float_t maxA = 0;
+        uint32_t imax = i;
+
+        for (uint32_t k = i; k < n; k++)
+        {
+            const ifx_Float_t absA = ifx_math_abs_r(a[n * P[k] + i]);
+            if (absA > maxA)
+            {
+                maxA = absA;
+                imax = k;
+            }
+        }
+
+        if (maxA == 0)
+            return 0;
+
+        if (imax != i)
+        {
+            const uint32_t t = P[i];
+            P[i] = P[imax];
+            P[imax] = t;
+            det = -det;
+        }
+
+        const ifx_Float_t* pivot_row = &a[n * P[i]];
+        det *= pivot_row[i];
+
+        for (uint32_t j = i + 1; j < n; j++)
+        {
+            ifx_Float_t* row = &a[n * P[j]];
+            row[i] = row[i] / pivot_row[i];
+
+            for (uint32_t k = i + 1; k < n; k++)
+                row[k] -= row[i] * pivot_row[k];
+        }
+    }
+
+    if (r == NULL)
+        return det;
+
+    // column j of the inverse solves L U x = P e_j
+    for (uint32_t j = 0; j < n; j++)
+    {
+        ifx_Float_t x[LA_SMALL_MAX];
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            x[i] = (P[i] == j) ? (ifx_Float_t)1 : (ifx_Float_t)0;
+            for (uint32_t k = 0; k < i; k++)
+                x[i] -= a[n * P[i] + k] * x[k];
+        }
+
+        for (uint32_t i = n; i-- > 0;)
+        {
+            for (uint32_t k = i + 1; k < n; k++)
+                x[i] -= a[n * P[i] + k] * x[k];
+            x[i] = x[i] / a[n * P[i] + i];
+        }
+
+        for (uint32_t i = 0; i < n; i++)
+            r[n * i + j] = x[i];
+    }
+
+    return det;
+}
+
+//----------------------------------------------------------------------------
+
+static ifx_Complex_t invert_lu_c(const ifx_Complex_t* m, uint32_t n, ifx_Complex_t* r)
+{
+    ifx_Complex_t a[LA_SMALL_MAX * LA_SMALL_MAX];
+    uint32_t P[LA_SMALL_MAX];
+    ifx_Complex_t det = ifx_complex_one;
+
+    memcpy(a, m, sizeof(ifx_Complex_t) * n * n);
+
+    for (uint32_t i = 0; i < n; i++)
+        P[i] = i;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        ifx_Float_t maxA = 0;
+        uint32_t imax = i;
+
+        for (uint32_t k = i; k < n; k++)
+        {
+            const ifx_Float_t absA = cnorm(a[n * P[k] + i]);
+            if (absA > maxA)
+            {
+                maxA = absA;
+                imax = k;
+            }
+        }
+
+        if (maxA == 0)
+            return ifx_complex_zero;
+
+        if (imax != i)
+        {
+            const uint32_t t = P[i];
+            P[i] = P[imax];
+            P[imax] = t;
+            IFX_COMPLEX_SET(det, -IFX_COMPLEX_REAL(det), -IFX_COMPLEX_IMAG(det));
+        }
+
+        const ifx_Complex_t* pivot_row = &a[n * P[i]];
+        det = cmul(det, pivot_row[i]);
+
+        for (uint32_t j = i + 1; j < n; j++)
+        {
+            ifx_Complex_t* row = &a[n * P[j]];
+            row[i] = cdiv(row[i], pivot_row[i]);
+
+            for (uint32_t k = i + 1; k < n; k++)
+                row[k] = csub(row[k], cmul(row[i], pivot_row[k]));
+        }
+    }
+
+    if (r == NULL)
+        return det;
+
+    // column j of the inverse solves L U x = P e_j
+    for (uint32_t j = 0; j < n; j++)
+    {
+        ifx_Complex_t x[LA_SMALL_MAX];
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            x[i] = (P[i] == j) ? ifx_complex_one : ifx_complex_zero;
+            for (uint32_t k = 0; k < i; k++)
+                x[i] = csub(x[i], cmul(a[n * P[i] + k], x[k]));
+        }
+
+        for (uint32_t i = n; i-- > 0;)
+        {
+            for (uint32_t k = i + 1; k < n; k++)
+                x[i] = csub(x[i], cmul(a[n * P[i] + k], x[k]));
+            x[i] = cdiv(x[i], a[n * P[i] + i]);
+        }
+
+        for (uint32_t i = 0; i < n; i++)
+            r[n * i + j] = x[i];
+    }
+
+    return det;
+}
+
+//----------------------------------------------------------------------------
+
+static bool small_invert_r(const ifx_Float_t* a, size_t lda, uint32_t n,
+                           ifx_Float_t* inverse, size_t ldi, ifx_Float_t* determinant)
+{
+    ifx_Float_t m[LA_SMALL_MAX * LA_SMALL_MAX];
+    ifx_Float_t r[LA_SMALL_MAX * LA_SMALL_MAX];
+    double det;
+    double norms = 1;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double norm2 = 0;
+        for (uint32_t j = 0; j < n; j++)
+        {
+            m[n * i + j] = a[lda * i + j];
+            norm2 += (double)m[n * i + j] * m[n * i + j];
+        }
+        norms *= sqrt(norm2);
+    }
+
+    switch (n)
+    {
+    case 1:
+        det = m[0];
+        r[0] = 1 / m[0];
+        break;
+    case 2:
+        det = invert2_r(m, r);
+        break;
+    default:
+        det = invert_lu_r(m, n, inverse ? r : NULL);
+        break;
+    }
+
+    if (determinant)
+        *determinant = (ifx_Float_t)det;
+
+    // the product of the row norms bounds |det| (Hadamard), so comparing
+    // against it makes the test independent of the scale of the matrix
+    if ((det == 0) || (fabs(det) <= n * FLT_EPSILON * norms))
+        return false;
+
+    if (inverse)
+    {
+        for (uint32_t i = 0; i < n; i++)
+        {
+            for (uint32_t j = 0; j < n; j++)
+                inverse[ldi * i + j] = r[n * i + j];
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+static bool small_invert_c(const ifx_Complex_t* a, size_t lda, uint32_t n,
+                           ifx_Complex_t* inverse, size_t ldi, ifx_Complex_t* determinant)
+{
+    ifx_Complex_t m[LA_SMALL_MAX * LA_SMALL_MAX];
+    ifx_Complex_t r[LA_SMALL_MAX * LA_SMALL_MAX];
+    ifx_Complex_t det;
+    double norms = 1;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double norm2 = 0;
+        for (uint32_t j = 0; j < n; j++)
+        {
+            m[n * i + j] = a[lda * i + j];
+            norm2 += (double)IFX_COMPLEX_REAL(m[n * i + j]) * IFX_COMPLEX_REAL(m[n * i + j]) +
+                     (double)IFX_COMPLEX_IMAG(m[n * i + j]) * IFX_COMPLEX_IMAG(m[n * i + j]);
+        }
+        norms *= sqrt(norm2);
+    }
+
+    switch (n)
+    {
+    case 1:
+        det = m[0];
+        r[0] = crecip(m[0]);
+        break;
+    case 2:
+        det = invert2_c(m, r);
+        break;
+    default:
+        det = invert_lu_c(m, n, inverse ? r : NULL);
+        break;
+    }
+
+    if (determinant)
+        *determinant = det;
+
+    const double abs_det = hypot(IFX_COMPLEX_REAL(det), IFX_COMPLEX_IMAG(det));
+    if ((abs_det == 0) || (abs_det <= n * FLT_EPSILON * norms))
+        return false;
+
+    if (inverse)
+    {
+        for (uint32_t i = 0; i < n; i++)
+        {
+            for (uint32_t j = 0; j < n; j++)
+                inverse[ldi * i + j] = r[n * i + j];
+        }
+    }
+
+    return true;
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -805,6 +1266,13 @@ void ifx_la_invert_r(const ifx_Matrix_R_t* A,
     // Dimension
     uint32_t N = mCols(A);
 
+    if (N <= LA_SMALL_MAX)
+    {
+        if (!small_invert_r(mDat(A), mLda(A), N, mDat(Ainv), mLda(Ainv), NULL))
+            ifx_error_set(IFX_ERROR_MATRIX_SINGULAR);
+        return;
+    }
+
     uint32_t* P = NULL;
     ifx_Matrix_R_t* LU = NULL;
 
@@ -848,6 +1316,13 @@ void ifx_la_invert_c(const ifx_Matrix_C_t* A,
     // Dimension
     uint32_t N = mCols(A);
 
+    if (N <= LA_SMALL_MAX)
+    {
+        if (!small_invert_c(mDat(A), mLda(A), N, mDat(Ainv), mLda(Ainv), NULL))
+            ifx_error_set(IFX_ERROR_MATRIX_SINGULAR);
+        return;
+    }
+
     uint32_t* P = NULL;
     ifx_Matrix_C_t* LU = NULL;
 
@@ -952,6 +1427,12 @@ void ifx_la_determinant_r(const ifx_Matrix_R_t* A,
     // Dimension
     uint32_t N = mCols(A);
 
+    if (N <= LA_SMALL_MAX)
+    {
+        small_invert_r(mDat(A), mLda(A), N, NULL, 0, determinant);
+        return;
+    }
+
     ifx_Matrix_R_t* B = ifx_mat_create_r(N, N);
 
     if (!B)
@@ -974,6 +1455,12 @@ void ifx_la_determinant_c(const ifx_Matrix_C_t* A,
     // Dimension
     uint32_t N = mCols(A);
 
+    if (N <= LA_SMALL_MAX)
+    {
+        small_invert_c(mDat(A), mLda(A), N, NULL, 0, determinant);
+        return;
+    }
+
     ifx_Matrix_C_t* B = ifx_mat_create_c(N, N);
 
     if (!B)
@@ -985,3 +1472,131 @@ void ifx_la_determinant_c(const ifx_Matrix_C_t* A,
     determinant_c_inplace(B, determinant);
     ifx_mat_destroy_c(B);
 }
+
+//----------------------------------------------------------------------------
+
+void ifx_la_invert_cube_r(const ifx_Cube_R_t* A,
+                          ifx_Cube_R_t* Ainv)
+{
+    IFX_ERR_BRK_NULL(A);
+    IFX_ERR_BRK_NULL(Ainv);
+    IFX_ERR_BRK_COND(cRows(A) != cCols(A), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_CUBE_BRK_DIM(A, Ainv);
+
+    const uint32_t N = cRows(A);
+    bool singular = false;
+
+    for (uint32_t s = 0; s < cSlices(A); s++)
+    {
+        const ifx_Float_t* a = &IFX_CUBE_SLICE_AT(A, s);
+        ifx_Float_t* inverse = &IFX_CUBE_SLICE_AT(Ainv, s);
+
+        if (N <= LA_SMALL_MAX)
+        {
+            singular |= !small_invert_r(a, N, N, inverse, N, NULL);
+        }
+        else
+        {
+            ifx_Matrix_R_t a_view, inverse_view;
+            ifx_mat_rawview_r(&a_view, (ifx_Float_t*)a, N, N, N);
+            ifx_mat_rawview_r(&inverse_view, inverse, N, N, N);
+            ifx_la_invert_r(&a_view, &inverse_view);
+        }
+    }
+
+    if (singular)
+        ifx_error_set(IFX_ERROR_MATRIX_SINGULAR);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_la_invert_cube_c(const ifx_Cube_C_t* A,
+                          ifx_Cube_C_t* Ainv)
+{
+    IFX_ERR_BRK_NULL(A);
+    IFX_ERR_BRK_NULL(Ainv);
+    IFX_ERR_BRK_COND(cRows(A) != cCols(A), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_CUBE_BRK_DIM(A, Ainv);
+
+    const uint32_t N = cRows(A);
+    bool singular = false;
+
+    for (uint32_t s = 0; s < cSlices(A); s++)
+    {
+        const ifx_Complex_t* a = &IFX_CUBE_SLICE_AT(A, s);
+        ifx_Complex_t* inverse = &IFX_CUBE_SLICE_AT(Ainv, s);
+
+        if (N <= LA_SMALL_MAX)
+        {
+            singular |= !small_invert_c(a, N, N, inverse, N, NULL);
+        }
+        else
+        {
+            ifx_Matrix_C_t a_view, inverse_view;
+            ifx_mat_rawview_c(&a_view, (ifx_Complex_t*)a, N, N, N);
+            ifx_mat_rawview_c(&inverse_view, inverse, N, N, N);
+            ifx_la_invert_c(&a_view, &inverse_view);
+        }
+    }
+
+    if (singular)
+        ifx_error_set(IFX_ERROR_MATRIX_SINGULAR);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_la_determinant_cube_r(const ifx_Cube_R_t* A,
+                               ifx_Vector_R_t* determinants)
+{
+    IFX_ERR_BRK_NULL(A);
+    IFX_VEC_BRK_VALID(determinants);
+    IFX_ERR_BRK_COND(cRows(A) != cCols(A), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(cSlices(A) != vLen(determinants), IFX_ERROR_DIMENSION_MISMATCH);
+
+    const uint32_t N = cRows(A);
+
+    for (uint32_t s = 0; s < cSlices(A); s++)
+    {
+        const ifx_Float_t* a = &IFX_CUBE_SLICE_AT(A, s);
+
+        if (N <= LA_SMALL_MAX)
+        {
+            small_invert_r(a, N, N, NULL, 0, &vAt(determinants, s));
+        }
+        else
+        {
+            ifx_Matrix_R_t a_view;
+            ifx_mat_rawview_r(&a_view, (ifx_Float_t*)a, N, N, N);
+            ifx_la_determinant_r(&a_view, &vAt(determinants, s));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_la_determinant_cube_c(const ifx_Cube_C_t* A,
+                               ifx_Vector_C_t* determinants)
+{
+    IFX_ERR_BRK_NULL(A);
+    IFX_VEC_BRK_VALID(determinants);
+    IFX_ERR_BRK_COND(cRows(A) != cCols(A), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(cSlices(A) != vLen(determinants), IFX_ERROR_DIMENSION_MISMATCH);
+
+    const uint32_t N = cRows(A);
+
+    for (uint32_t s = 0; s < cSlices(A); s++)
+    {
+        const ifx_Complex_t* a = &IFX_CUBE_SLICE_AT(A, s);
+
+        if (N <= LA_SMALL_MAX)
+        {
+            small_invert_c(a, N, N, NULL, 0, &vAt(determinants, s));
+        }
+        else
+        {
+            ifx_Matrix_C_t a_view;
+            ifx_mat_rawview_c(&a_view, (ifx_Complex_t*)a, N, N, N);
+            ifx_la_determinant_c(&a_view, &vAt(determinants, s));
+        }
+    }
+}
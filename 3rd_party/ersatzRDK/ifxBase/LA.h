@@ -50,7 +50,9 @@ extern "C"
 */
 
 #include "ifxBase/Types.h"
+#include "ifxBase/Cube.h"
 #include "ifxBase/Matrix.h"
+#include "ifxBase/Vector.h"
 
 /*
 ==============================================================================
@@ -80,6 +82,13 @@ extern "C"
   * Supports linear algebra operations such as LU,
   * Cholesky decomposition, or inverting matrices
   *
+  * Inverses and determinants of matrices up to 4x4, e.g. covariance
+  * matrices of the receive antennas, are computed with fixed size kernels
+  * on the stack: closed form for 2x2 and 3x3, Gauss-Jordan elimination with
+  * partial pivoting for 4x4. Larger matrices use an LU decomposition with
+  * partial pivoting and temporary memory from the heap. The cube variants
+  * process every slice of a cube, e.g. one matrix per range bin.
+  *
   * @{
   */
 
@@ -90,6 +99,8 @@ extern "C"
  *
  * This function works for generic real square matrices. If A is (numerically)
  * singular, IFX_ERROR_MATRIX_SINGULAR is set.
+ * Matrices up to 4x4 are considered singular if |det(A)| is at most
+ * N * FLT_EPSILON times the product of the row norms of A.
  *
  * @param [in]     A         input matrix A
  * @param [out]    Ainv      inverse of matrix A
@@ -106,6 +117,8 @@ void ifx_la_invert_r(const ifx_Matrix_R_t* A,
  *
  * This function works for generic complex square matrices. If A is
  * (numerically) singular, IFX_ERROR_MATRIX_SINGULAR is set.
+ * Matrices up to 4x4 are considered singular if |det(A)| is at most
+ * N * FLT_EPSILON times the product of the row norms of A.
  *
  * @param [in]     A         input matrix A
  * @param [out]    Ainv      inverse of matrix A
@@ -187,6 +200,58 @@ IFX_DLL_PUBLIC
 void ifx_la_determinant_c(const ifx_Matrix_C_t* A,
                           ifx_Complex_t* determinant);
 
+/**
+ * @brief Computes the inverses of all slices of a real cube
+ *
+ * Every slice of A (rows x cols with rows = cols) is inverted into the
+ * same slice of Ainv. If any slice is (numerically) singular,
+ * IFX_ERROR_MATRIX_SINGULAR is set after all slices have been processed.
+ *
+ * @param [in]     A         cube of square matrices
+ * @param [out]    Ainv      cube of inverse matrices
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_la_invert_cube_r(const ifx_Cube_R_t* A,
+                          ifx_Cube_R_t* Ainv);
+
+/**
+ * @brief Computes the inverses of all slices of a complex cube
+ *
+ * See \ref ifx_la_invert_cube_r.
+ *
+ * @param [in]     A         cube of square matrices
+ * @param [out]    Ainv      cube of inverse matrices
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_la_invert_cube_c(const ifx_Cube_C_t* A,
+                          ifx_Cube_C_t* Ainv);
+
+/**
+ * @brief Computes the determinants of all slices of a real cube
+ *
+ * @param [in]     A                   cube of square matrices
+ * @param [out]    determinants        determinant of every slice, length
+ *                                     equal to the number of slices
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_la_determinant_cube_r(const ifx_Cube_R_t* A,
+                               ifx_Vector_R_t* determinants);
+
+/**
+ * @brief Computes the determinants of all slices of a complex cube
+ *
+ * @param [in]     A                   cube of square matrices
+ * @param [out]    determinants        determinant of every slice, length
+ *                                     equal to the number of slices
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_la_determinant_cube_c(const ifx_Cube_C_t* A,
+                               ifx_Vector_C_t* determinants);
+
 /**
   * @}
   */
@@ -0,0 +1,225 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <stdbool.h>
+
+#include "ifxBase/MTI.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Mem.h"
+#include "ifxBase/internal/Macros.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+struct ifx_MTI_s
+{
+    ifx_MTI_Mode_t mode;
+    uint32_t num_samples;
+    uint32_t num_chirps;
+    uint32_t num_antennas;
+    ifx_Float_t alpha;
+
+    ifx_Matrix_R_t* background;     /**< [antenna][sample] */
+    bool has_background;
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static ifx_Float_t mean(const ifx_Float_t* x, uint32_t len);
+
+static void subtract(const ifx_Float_t* x, ifx_Float_t value, uint32_t len, ifx_Float_t* y);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static ifx_Float_t mean(const ifx_Float_t* x, uint32_t len)
+{
+    // independent partial sums, a single accumulator serializes the adds
+    ifx_Float_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    uint32_t i = 0;
+
+    for (; i + 4 <= len; i += 4)
+    {
+        s0 += x[i];
+        s1 += x[i + 1];
+        s2 += x[i + 2];
+        s3 += x[i + 3];
+    }
+    for (; i < len; i++)
+        s0 += x[i];
+
+    return ((s0 + s1) + (s2 + s3)) / len;
+}
+
+//----------------------------------------------------------------------------
+
+static void subtract(const ifx_Float_t* x, ifx_Float_t value, uint32_t len, ifx_Float_t* y)
+{
+    for (uint32_t i = 0; i < len; i++)
+        y[i] = x[i] - value;
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_MTI_t* ifx_mti_create(const ifx_MTI_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_ARGUMENT((config->mode != IFX_MTI_MEAN_CHIRP) && (config->mode != IFX_MTI_BACKGROUND));
+    IFX_ERR_BRN_ARGUMENT((config->num_samples_per_chirp == 0) ||
+                         (config->num_chirps_per_frame == 0) ||
+                         (config->num_antennas == 0));
+    IFX_ERR_BRN_ARGUMENT((config->mode == IFX_MTI_BACKGROUND) &&
+                         !((config->alpha > 0) && (config->alpha <= 1)));
+
+    ifx_MTI_t* handle = ifx_mem_calloc(1, sizeof(ifx_MTI_t));
+    IFX_ERR_BRN_MEMALLOC(handle);
+
+    handle->mode = config->mode;
+    handle->num_samples = config->num_samples_per_chirp;
+    handle->num_chirps = config->num_chirps_per_frame;
+    handle->num_antennas = config->num_antennas;
+    handle->alpha = config->alpha;
+
+    handle->background = ifx_mat_create_r(handle->num_antennas, handle->num_samples);
+    if (!handle->background)
+    {
+        ifx_mti_destroy(handle);
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return NULL;
+    }
+
+    return handle;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mti_destroy(ifx_MTI_t* handle)
+{
+    if (handle == NULL)
+        return;
+
+    ifx_mat_destroy_r(handle->background);
+    ifx_mem_free(handle);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mti_reset(ifx_MTI_t* handle)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    ifx_mat_clear_r(handle->background);
+    handle->has_background = false;
+}
+
+//----------------------------------------------------------------------------
+
+const ifx_Matrix_R_t* ifx_mti_get_background(const ifx_MTI_t* handle)
+{
+    IFX_ERR_BRN_NULL(handle);
+
+    return handle->background;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mti_run(ifx_MTI_t* handle,
+                 const ifx_Cube_R_t* input,
+                 ifx_Cube_R_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(input);
+    IFX_ERR_BRK_NULL(output);
+    IFX_ERR_BRK_COND((cSlices(input) != handle->num_samples) ||
+                     (cRows(input) != handle->num_antennas) ||
+                     (cCols(input) != handle->num_chirps), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND((cSlices(output) != handle->num_samples) ||
+                     (cRows(output) != handle->num_antennas) ||
+                     (cCols(output) != handle->num_chirps), IFX_ERROR_DIMENSION_MISMATCH);
+
+    const uint32_t num_chirps = handle->num_chirps;
+    const bool update = (handle->mode == IFX_MTI_BACKGROUND) && handle->has_background;
+    const ifx_Float_t alpha = handle->alpha;
+
+    for (uint32_t s = 0; s < handle->num_samples; s++)
+    {
+        for (uint32_t a = 0; a < handle->num_antennas; a++)
+        {
+            const ifx_Float_t* x = &cAt(input, a, 0, s);
+            ifx_Float_t clutter = mean(x, num_chirps);
+
+            if (handle->mode == IFX_MTI_BACKGROUND)
+            {
+                ifx_Float_t* b = &mAt(handle->background, a, s);
+
+                if (update)
+                    *b += alpha * (clutter - *b);
+                else
+                    *b = clutter;
+                clutter = *b;
+            }
+
+            subtract(x, clutter, num_chirps, &cAt(output, a, 0, s));
+        }
+    }
+
+    handle->has_background = true;
+}
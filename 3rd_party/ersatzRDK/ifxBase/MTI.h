@@ -0,0 +1,194 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file MTI.h
+ *
+ * \brief \copybrief gr_mti
+ *
+ * For details refer to \ref gr_mti
+ */
+
+#ifndef IFX_BASE_MTI_H
+#define IFX_BASE_MTI_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Cube.h"
+#include "ifxBase/Defines.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Types.h"
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Defines how the static clutter is estimated.
+ */
+typedef enum
+{
+    IFX_MTI_MEAN_CHIRP = 0U,    /**< Mean of all chirps of the current frame */
+    IFX_MTI_BACKGROUND = 1U,    /**< Exponential average of the chirp means of all frames so far */
+} ifx_MTI_Mode_t;
+
+/**
+ * @brief Configuration of a moving target indication stage.
+ */
+typedef struct
+{
+    ifx_MTI_Mode_t mode;                    /**< Clutter estimate */
+    uint32_t num_samples_per_chirp;         /**< Samples per chirp of the input frames */
+    uint32_t num_chirps_per_frame;          /**< Chirps per frame of the input frames */
+    uint32_t num_antennas;                  /**< Antennas of the input frames */
+    ifx_Float_t alpha;                      /**< Weight of the newest frame in the background
+                                                 estimate, in (0, 1], only used by
+                                                 \ref IFX_MTI_BACKGROUND */
+} ifx_MTI_Config_t;
+
+/**
+ * @brief Forward declaration structure for a moving target indication stage.
+ */
+typedef struct ifx_MTI_s ifx_MTI_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_SDK_base
+  * @{
+  */
+
+/** @defgroup gr_mti Moving Target Indication
+  * @brief API for removing static clutter from radar frames
+  *
+  * Input frames are real cubes with the layout [sample][antenna][chirp] as
+  * delivered by the acquisition, so the stage runs between fetching a frame
+  * and its range FFT. Echoes of static objects produce the same beat signal
+  * in every chirp; the stage estimates this signal per antenna and sample
+  * and subtracts it from all chirps. As the range FFT is linear this
+  * removes the static part of every range bin.
+  *
+  * With \ref IFX_MTI_MEAN_CHIRP the estimate is the mean of the chirps of
+  * the frame itself. With \ref IFX_MTI_BACKGROUND it is the background
+  * b = b + alpha * (mean - b) updated with every frame, which also keeps
+  * targets moving slowly within a frame. The first frame after creating or
+  * resetting the stage initializes the background.
+  *
+  * The state is preallocated when the stage is created, running it doesn't
+  * allocate. The chirps of one antenna and sample are contiguous, so both
+  * the mean and the subtraction are single sweeps over consecutive memory.
+  *
+  * @{
+  */
+
+/**
+ * @brief Creates a moving target indication stage.
+ *
+ * @param [in]     config    Configuration.
+ *
+ * @return Handle to the stage, NULL in case of an error.
+ */
+IFX_DLL_PUBLIC
+ifx_MTI_t* ifx_mti_create(const ifx_MTI_Config_t* config);
+
+/**
+ * @brief Destroys a moving target indication stage.
+ *
+ * @param [in]     handle    Stage to destroy, may be NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_mti_destroy(ifx_MTI_t* handle);
+
+/**
+ * @brief Discards the background estimate, the next frame starts a new one.
+ *
+ * @param [in]     handle    Stage.
+ */
+IFX_DLL_PUBLIC
+void ifx_mti_reset(ifx_MTI_t* handle);
+
+/**
+ * @brief Returns the current background estimate.
+ *
+ * @param [in]     handle    Stage.
+ *
+ * @return Matrix with num_antennas rows and num_samples_per_chirp columns,
+ *         owned by the stage. Only valid after the first frame in
+ *         \ref IFX_MTI_BACKGROUND mode.
+ */
+IFX_DLL_PUBLIC
+const ifx_Matrix_R_t* ifx_mti_get_background(const ifx_MTI_t* handle);
+
+/**
+ * @brief Removes the static clutter from a frame.
+ *
+ * @param [in]     handle    Stage.
+ * @param [in]     input     Frame with num_samples_per_chirp slices,
+ *                           num_antennas rows and num_chirps_per_frame columns.
+ * @param [out]    output    Cube with the dimensions of the input, may be the
+ *                           input itself.
+ */
+IFX_DLL_PUBLIC
+void ifx_mti_run(ifx_MTI_t* handle,
+                 const ifx_Cube_R_t* input,
+                 ifx_Cube_R_t* output);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif /* IFX_BASE_MTI_H */
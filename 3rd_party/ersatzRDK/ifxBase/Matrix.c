@@ -43,6 +43,7 @@
 #include "ifxBase/Vector.h"
 #include "ifxBase/Mem.h"
 #include "ifxBase/Error.h"
+#include "ifxBase/internal/Simd.h"
 
 
 /*
@@ -98,12 +99,50 @@
         }                                                               \
     } while(0)
 
+/* Register block of the GEMM micro kernel, GEMM_MR rows times GEMM_NR
+ * columns of the result are accumulated in 8 SIMD registers */
+#define GEMM_MR 4
+#define GEMM_NR 8
+
+/* Cache blocks: a GEMM_MC x GEMM_KC block of the left operand stays in L2,
+ * a GEMM_KC x GEMM_NR panel of the right operand in L1 */
+#define GEMM_MC 64
+#define GEMM_KC 256
+#define GEMM_NC 512
+
+/* Products with fewer multiply-adds, or with less rows or columns than the
+ * register block, are computed directly without packing */
+#define GEMM_SMALL (16 * 16 * 16)
+
 /*
 ==============================================================================
    3. LOCAL TYPES
 ==============================================================================
 */
 
+/**
+ * @brief Real matrix operand of a GEMM, element (r, c) is d[r * rs + c * cs].
+ *
+ * Transposed matrices swap the strides, the real and imaginary parts of a
+ * complex matrix are views with twice the strides.
+ */
+typedef struct
+{
+    const ifx_Float_t* d;
+    size_t rs;
+    size_t cs;
+} gemm_operand_t;
+
+/**
+ * @brief Real matrix result of a GEMM, element (r, c) is d[r * rs + c * cs].
+ */
+typedef struct
+{
+    ifx_Float_t* d;
+    size_t rs;
+    size_t cs;
+} gemm_result_t;
+
 /**
  * @brief Structure used to store matrix allocation parameters
  */
@@ -149,6 +188,65 @@ typedef struct Matrix_alloc_params
  */
 static bool matrix_alloc_size_overflow(size_t rows, size_t columns, size_t elem_size, size_t data_offset, size_t* alloc_size);
 
+static inline gemm_operand_t gemm_operand_r(const ifx_Matrix_R_t* matrix, bool transpose);
+
+static inline gemm_operand_t gemm_operand_c(const ifx_Matrix_C_t* matrix, bool transpose, uint32_t part);
+
+static inline gemm_result_t gemm_result_r(ifx_Matrix_R_t* matrix);
+
+static inline gemm_result_t gemm_result_c(ifx_Matrix_C_t* matrix, uint32_t part);
+
+/**
+ * @brief Computes C = alpha * A * B, or C += alpha * A * B if accumulate is
+ *        set, with A of size m x k and B of size k x n.
+ *
+ * Small products are computed directly in the loop order that walks the
+ * operands contiguously. Larger ones pack blocks of A and B into panels
+ * matching the register block of \ref gemm_kernel, so the kernel only reads
+ * contiguous aligned memory whatever the strides of the operands are. If the
+ * packing buffers can't be allocated the direct loops are used.
+ */
+static void gemm(uint32_t m, uint32_t n, uint32_t k, ifx_Float_t alpha,
+                 gemm_operand_t a, gemm_operand_t b, bool accumulate, gemm_result_t c);
+
+static void gemm_small(uint32_t m, uint32_t n, uint32_t k, ifx_Float_t alpha,
+                       gemm_operand_t a, gemm_operand_t b, bool accumulate, gemm_result_t c);
+
+/**
+ * @brief Packs rows i0..i0+mc and columns l0..l0+kc of A, scaled by alpha,
+ *        into panels of GEMM_MR rows stored column by column. Missing rows
+ *        of the last panel are zero.
+ */
+static void gemm_pack_a(uint32_t mc, uint32_t kc, ifx_Float_t alpha, gemm_operand_t a,
+                        uint32_t i0, uint32_t l0, ifx_Float_t* packed);
+
+/**
+ * @brief Packs rows l0..l0+kc and columns j0..j0+nc of B into panels of
+ *        GEMM_NR columns stored row by row. Missing columns of the last
+ *        panel are zero.
+ */
+static void gemm_pack_b(uint32_t kc, uint32_t nc, gemm_operand_t b,
+                        uint32_t l0, uint32_t j0, ifx_Float_t* packed);
+
+/**
+ * @brief Multiplies a packed panel of A with a packed panel of B into a
+ *        GEMM_MR x GEMM_NR tile.
+ */
+static void gemm_kernel(uint32_t kc, const ifx_Float_t* a, const ifx_Float_t* b,
+                        ifx_Float_t tile[GEMM_MR * GEMM_NR]);
+
+/**
+ * @brief Computes the complex product C = A * B or C = A * conj(B) from
+ *        real GEMMs of the real and imaginary parts.
+ *
+ * The imaginary part of a real operand is passed with d set to NULL, its
+ * products are skipped.
+ */
+static void gemm_complex(uint32_t m, uint32_t n, uint32_t k,
+                         gemm_operand_t a_re, gemm_operand_t a_im,
+                         gemm_operand_t b_re, gemm_operand_t b_im, bool conjugate_b,
+                         gemm_result_t c_re, gemm_result_t c_im);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
@@ -164,6 +262,278 @@ static bool matrix_alloc_size_overflow(size_t rows, size_t columns, size_t elem_
     return ifx_util_overflow_add_size_t(*alloc_size, data_offset, alloc_size);
 }
 
+//----------------------------------------------------------------------------
+
+static inline gemm_operand_t gemm_operand_r(const ifx_Matrix_R_t* matrix, bool transpose)
+{
+    gemm_operand_t op = { mDat(matrix), mLda(matrix), 1 };
+    if (transpose)
+    {
+        op.rs = 1;
+        op.cs = mLda(matrix);
+    }
+    return op;
+}
+
+//----------------------------------------------------------------------------
+
+static inline gemm_operand_t gemm_operand_c(const ifx_Matrix_C_t* matrix, bool transpose, uint32_t part)
+{
+    gemm_operand_t op = { &mDat(matrix)->data[part], 2 * (size_t)mLda(matrix), 2 };
+    if (transpose)
+    {
+        op.rs = 2;
+        op.cs = 2 * (size_t)mLda(matrix);
+    }
+    return op;
+}
+
+//----------------------------------------------------------------------------
+
+static inline gemm_result_t gemm_result_r(ifx_Matrix_R_t* matrix)
+{
+    gemm_result_t res = { mDat(matrix), mLda(matrix), 1 };
+    return res;
+}
+
+//----------------------------------------------------------------------------
+
+static inline gemm_result_t gemm_result_c(ifx_Matrix_C_t* matrix, uint32_t part)
+{
+    gemm_result_t res = { &mDat(matrix)->data[part], 2 * (size_t)mLda(matrix), 2 };
+    return res;
+}
+
+//----------------------------------------------------------------------------
+
+static void gemm_small(uint32_t m, uint32_t n, uint32_t k, ifx_Float_t alpha,
+                       gemm_operand_t a, gemm_operand_t b, bool accumulate, gemm_result_t c)
+{
+    if (b.rs == 1)
+    {
+        // columns of B are contiguous (B is transposed): dot products
+        for (uint32_t i = 0; i < m; i++)
+        {
+            const ifx_Float_t* a_row = a.d + i * a.rs;
+            for (uint32_t j = 0; j < n; j++)
+            {
+                const ifx_Float_t* b_col = b.d + j * b.cs;
+                ifx_Float_t sum = 0;
+                for (uint32_t l = 0; l < k; l++)
+                    sum += a_row[l * a.cs] * b_col[l];
+
+                ifx_Float_t* dst = &c.d[i * c.rs + j * c.cs];
+                *dst = accumulate ? *dst + alpha * sum : alpha * sum;
+            }
+        }
+        return;
+    }
+
+    // otherwise rows of B are added to the rows of C
+    for (uint32_t i = 0; i < m; i++)
+    {
+        ifx_Float_t* c_row = c.d + i * c.rs;
+        if (!accumulate)
+        {
+            for (uint32_t j = 0; j < n; j++)
+                c_row[j * c.cs] = 0;
+        }
+
+        for (uint32_t l = 0; l < k; l++)
+        {
+            const ifx_Float_t a_il = alpha * a.d[i * a.rs + l * a.cs];
+            const ifx_Float_t* b_row = b.d + l * b.rs;
+            for (uint32_t j = 0; j < n; j++)
+                c_row[j * c.cs] += a_il * b_row[j * b.cs];
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void gemm_pack_a(uint32_t mc, uint32_t kc, ifx_Float_t alpha, gemm_operand_t a,
+                        uint32_t i0, uint32_t l0, ifx_Float_t* packed)
+{
+    for (uint32_t ir = 0; ir < mc; ir += GEMM_MR)
+    {
+        const uint32_t mr = MIN(GEMM_MR, mc - ir);
+        const ifx_Float_t* src = a.d + (i0 + ir) * a.rs + l0 * a.cs;
+
+        for (uint32_t l = 0; l < kc; l++)
+        {
+            uint32_t ii = 0;
+            for (; ii < mr; ii++)
+                packed[ii] = alpha * src[ii * a.rs + l * a.cs];
+            for (; ii < GEMM_MR; ii++)
+                packed[ii] = 0;
+            packed += GEMM_MR;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void gemm_pack_b(uint32_t kc, uint32_t nc, gemm_operand_t b,
+                        uint32_t l0, uint32_t j0, ifx_Float_t* packed)
+{
+    for (uint32_t jr = 0; jr < nc; jr += GEMM_NR)
+    {
+        const uint32_t nr = MIN(GEMM_NR, nc - jr);
+        const ifx_Float_t* src = b.d + l0 * b.rs + (j0 + jr) * b.cs;
+
+        for (uint32_t l = 0; l < kc; l++)
+        {
+            uint32_t jj = 0;
+            for (; jj < nr; jj++)
+                packed[jj] = src[l * b.rs + jj * b.cs];
+            for (; jj < GEMM_NR; jj++)
+                packed[jj] = 0;
+            packed += GEMM_NR;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void gemm_kernel(uint32_t kc, const ifx_Float_t* a, const ifx_Float_t* b,
+                        ifx_Float_t tile[GEMM_MR * GEMM_NR])
+{
+    v4_t c00 = v4_set1(0), c01 = v4_set1(0);
+    v4_t c10 = v4_set1(0), c11 = v4_set1(0);
+    v4_t c20 = v4_set1(0), c21 = v4_set1(0);
+    v4_t c30 = v4_set1(0), c31 = v4_set1(0);
+
+    for (uint32_t l = 0; l < kc; l++)
+    {
+        const v4_t b0 = v4_load(b);
+        const v4_t b1 = v4_load(b + 4);
+        v4_t ai;
+
+        ai = v4_set1(a[0]);
+        c00 = v4_madd(c00, ai, b0);
+        c01 = v4_madd(c01, ai, b1);
+        ai = v4_set1(a[1]);
+        c10 = v4_madd(c10, ai, b0);
+        c11 = v4_madd(c11, ai, b1);
+        ai = v4_set1(a[2]);
+        c20 = v4_madd(c20, ai, b0);
+        c21 = v4_madd(c21, ai, b1);
+        ai = v4_set1(a[3]);
+        c30 = v4_madd(c30, ai, b0);
+        c31 = v4_madd(c31, ai, b1);
+
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+
+    v4_storeu(tile + 0, c00);
+    v4_storeu(tile + 4, c01);
+    v4_storeu(tile + 8, c10);
+    v4_storeu(tile + 12, c11);
+    v4_storeu(tile + 16, c20);
+    v4_storeu(tile + 20, c21);
+    v4_storeu(tile + 24, c30);
+    v4_storeu(tile + 28, c31);
+}
+
+//----------------------------------------------------------------------------
+
+static void gemm(uint32_t m, uint32_t n, uint32_t k, ifx_Float_t alpha,
+                 gemm_operand_t a, gemm_operand_t b, bool accumulate, gemm_result_t c)
+{
+    if ((m < GEMM_MR) || (n < GEMM_NR) || ((uint64_t)m * n * k <= GEMM_SMALL))
+    {
+        gemm_small(m, n, k, alpha, a, b, accumulate, c);
+        return;
+    }
+
+    const uint32_t kc_max = MIN(k, GEMM_KC);
+    const uint32_t mc_max = MIN((m + GEMM_MR - 1) / GEMM_MR * GEMM_MR, GEMM_MC);
+    const uint32_t nc_max = MIN((n + GEMM_NR - 1) / GEMM_NR * GEMM_NR, GEMM_NC);
+
+    ifx_Float_t* packed_a = ifx_mem_aligned_alloc(mc_max * kc_max * sizeof(ifx_Float_t), MEMORY_ALIGNMENT);
+    ifx_Float_t* packed_b = ifx_mem_aligned_alloc(nc_max * kc_max * sizeof(ifx_Float_t), MEMORY_ALIGNMENT);
+    if (!packed_a || !packed_b)
+    {
+        ifx_mem_aligned_free(packed_a);
+        ifx_mem_aligned_free(packed_b);
+        gemm_small(m, n, k, alpha, a, b, accumulate, c);
+        return;
+    }
+
+    ifx_Float_t tile[GEMM_MR * GEMM_NR];
+
+    for (uint32_t j0 = 0; j0 < n; j0 += GEMM_NC)
+    {
+        const uint32_t nc = MIN(GEMM_NC, n - j0);
+
+        for (uint32_t l0 = 0; l0 < k; l0 += GEMM_KC)
+        {
+            const uint32_t kc = MIN(GEMM_KC, k - l0);
+            const bool add = accumulate || (l0 > 0);
+
+            gemm_pack_b(kc, nc, b, l0, j0, packed_b);
+
+            for (uint32_t i0 = 0; i0 < m; i0 += GEMM_MC)
+            {
+                const uint32_t mc = MIN(GEMM_MC, m - i0);
+
+                gemm_pack_a(mc, kc, alpha, a, i0, l0, packed_a);
+
+                for (uint32_t jr = 0; jr < nc; jr += GEMM_NR)
+                {
+                    const uint32_t nr = MIN(GEMM_NR, nc - jr);
+
+                    for (uint32_t ir = 0; ir < mc; ir += GEMM_MR)
+                    {
+                        const uint32_t mr = MIN(GEMM_MR, mc - ir);
+
+                        gemm_kernel(kc, packed_a + ir * kc, packed_b + jr * kc, tile);
+
+                        ifx_Float_t* dst = c.d + (i0 + ir) * c.rs + (j0 + jr) * c.cs;
+                        for (uint32_t ii = 0; ii < mr; ii++)
+                        {
+                            for (uint32_t jj = 0; jj < nr; jj++)
+                            {
+                                ifx_Float_t* e = &dst[ii * c.rs + jj * c.cs];
+                                *e = add ? *e + tile[ii * GEMM_NR + jj] : tile[ii * GEMM_NR + jj];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    ifx_mem_aligned_free(packed_a);
+    ifx_mem_aligned_free(packed_b);
+}
+
+//----------------------------------------------------------------------------
+
+static void gemm_complex(uint32_t m, uint32_t n, uint32_t k,
+                         gemm_operand_t a_re, gemm_operand_t a_im,
+                         gemm_operand_t b_re, gemm_operand_t b_im, bool conjugate_b,
+                         gemm_result_t c_re, gemm_result_t c_im)
+{
+    const ifx_Float_t sign = conjugate_b ? -1 : 1;
+
+    // re(C) = re(A) re(B) - im(A) im(B)
+    gemm(m, n, k, 1, a_re, b_re, false, c_re);
+    if (a_im.d && b_im.d)
+        gemm(m, n, k, -sign, a_im, b_im, true, c_re);
+
+    // im(C) = re(A) im(B) + im(A) re(B)
+    bool accumulate = false;
+    if (b_im.d)
+    {
+        gemm(m, n, k, sign, a_re, b_im, false, c_im);
+        accumulate = true;
+    }
+    if (a_im.d)
+        gemm(m, n, k, 1, a_im, b_re, accumulate, c_im);
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -1063,17 +1433,9 @@ void ifx_mat_abt_r(const ifx_Matrix_R_t* inputA,
                      (inputB->rows != output->cols) ||
                      (inputA->cols != inputB->cols), IFX_ERROR_DIMENSION_MISMATCH)
 
-    for(uint32_t i_row = 0; i_row < inputA->rows; ++i_row)
-    {
-        for(uint32_t j_row = 0; j_row < inputB->rows; ++j_row)
-        {
-            ifx_Float_t sum = 0;
-            for(uint32_t col = 0; col < inputA->cols; ++col)
-                sum += mAt(inputA, i_row, col) * mAt(inputB, j_row, col);
-
-            mAt(output, i_row, j_row) = sum;
-        }
-    }
+    gemm(mRows(inputA), mRows(inputB), mCols(inputA), 1,
+         gemm_operand_r(inputA, false), gemm_operand_r(inputB, true),
+         false, gemm_result_r(output));
 }
 
 //----------------------------------------------------------------------------
@@ -1090,23 +1452,10 @@ void ifx_mat_abct_c(const ifx_Matrix_C_t* inputA,
                      (inputB->rows != output->cols) ||
                      (inputA->cols != inputB->cols), IFX_ERROR_DIMENSION_MISMATCH)
 
-    for(uint32_t i_row = 0; i_row < inputA->rows; ++i_row)
-    {
-        for(uint32_t j_row = 0; j_row < inputB->rows; ++j_row)
-        {
-            ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
-            for(uint32_t col = 0; col < inputA->cols; ++col)
-            {
-                ifx_Float_t ra = IFX_COMPLEX_REAL(mAt(inputA, i_row, col));
-                ifx_Float_t ia = IFX_COMPLEX_IMAG(mAt(inputA, i_row, col));
-                ifx_Float_t rb = IFX_COMPLEX_REAL(mAt(inputB, j_row, col));
-                ifx_Float_t ib = IFX_COMPLEX_IMAG(mAt(inputB, j_row, col));
-                ifx_Complex_t tmp = IFX_COMPLEX_DEF(ra*rb+ia*ib, -ra*ib+rb*ia);
-                sum = ifx_complex_add(sum, tmp);
-            }
-            mAt(output, i_row, j_row) = sum;
-        }
-    }
+    gemm_complex(mRows(inputA), mRows(inputB), mCols(inputA),
+                 gemm_operand_c(inputA, false, 0), gemm_operand_c(inputA, false, 1),
+                 gemm_operand_c(inputB, true, 0), gemm_operand_c(inputB, true, 1), true,
+                 gemm_result_c(output, 0), gemm_result_c(output, 1));
 }
 
 //----------------------------------------------------------------------------
@@ -1123,19 +1472,10 @@ void ifx_mat_abt_c(const ifx_Matrix_C_t* inputA,
                      (inputB->rows != output->cols) ||
                      (inputA->cols != inputB->cols), IFX_ERROR_DIMENSION_MISMATCH)
 
-    for(uint32_t i_row = 0; i_row < inputA->rows; ++i_row)
-    {
-        for(uint32_t j_row = 0; j_row < inputB->rows; ++j_row)
-        {
-            ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
-            for(uint32_t col = 0; col < inputA->cols; ++col)
-            {
-                ifx_Complex_t tmp = ifx_complex_mul(mAt(inputA, i_row, col), mAt(inputB, j_row, col));
-                sum = ifx_complex_add(sum, tmp);
-            }
-            mAt(output, i_row, j_row) = sum;
-        }
-    }
+    gemm_complex(mRows(inputA), mRows(inputB), mCols(inputA),
+                 gemm_operand_c(inputA, false, 0), gemm_operand_c(inputA, false, 1),
+                 gemm_operand_c(inputB, true, 0), gemm_operand_c(inputB, true, 1), false,
+                 gemm_result_c(output, 0), gemm_result_c(output, 1));
 }
 
 //----------------------------------------------------------------------------
@@ -1152,19 +1492,12 @@ void ifx_mat_abt_rc(const ifx_Matrix_R_t* inputA,
                      (inputB->rows != output->cols) ||
                      (inputA->cols != inputB->cols), IFX_ERROR_DIMENSION_MISMATCH)
 
-    for(uint32_t i_row = 0; i_row < inputA->rows; ++i_row)
-    {
-        for(uint32_t j_row = 0; j_row < inputB->rows; ++j_row)
-        {
-            ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
-            for(uint32_t col = 0; col < inputA->cols; ++col)
-            {
-                ifx_Complex_t tmp = ifx_complex_mul_real(mAt(inputB, j_row, col), mAt(inputA, i_row, col));
-                sum = ifx_complex_add(sum, tmp);
-            }
-            mAt(output, i_row, j_row) = sum;
-        }
-    }
+    const gemm_operand_t no_imag = { NULL, 0, 0 };
+
+    gemm_complex(mRows(inputA), mRows(inputB), mCols(inputA),
+                 gemm_operand_r(inputA, false), no_imag,
+                 gemm_operand_c(inputB, true, 0), gemm_operand_c(inputB, true, 1), false,
+                 gemm_result_c(output, 0), gemm_result_c(output, 1));
 }
 
 //----------------------------------------------------------------------------
@@ -1181,19 +1514,12 @@ void ifx_mat_abt_cr(const ifx_Matrix_C_t* inputA,
                      (inputB->rows != output->cols) ||
                      (inputA->cols != inputB->cols), IFX_ERROR_DIMENSION_MISMATCH)
 
-    for(uint32_t i_row = 0; i_row < inputA->rows; ++i_row)
-    {
-        for(uint32_t j_row = 0; j_row < inputB->rows; ++j_row)
-        {
-            ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
-            for(uint32_t col = 0; col < inputA->cols; ++col)
-            {
-                ifx_Complex_t tmp = ifx_complex_mul_real(mAt(inputA, i_row, col), mAt(inputB, j_row, col));
-                sum = ifx_complex_add(sum, tmp);
-            }
-            mAt(output, i_row, j_row) = sum;
-        }
-    }
+    const gemm_operand_t no_imag = { NULL, 0, 0 };
+
+    gemm_complex(mRows(inputA), mRows(inputB), mCols(inputA),
+                 gemm_operand_c(inputA, false, 0), gemm_operand_c(inputA, false, 1),
+                 gemm_operand_r(inputB, true), no_imag, false,
+                 gemm_result_c(output, 0), gemm_result_c(output, 1));
 }
 
 //----------------------------------------------------------------------------
@@ -1210,17 +1536,9 @@ void ifx_mat_atb_r(const ifx_Matrix_R_t* inputA,
                      (inputB->cols != output->cols) ||
                      (inputA->rows != inputB->rows), IFX_ERROR_DIMENSION_MISMATCH)
 
-    for(uint32_t i_col = 0; i_col < inputA->cols; ++i_col)
-    {
-        for(uint32_t j_col = 0; j_col < inputB->cols; ++j_col)
-        {
-            ifx_Float_t sum = 0;
-            for(uint32_t row = 0; row < inputA->rows; ++row)
-                sum += mAt(inputA, row, i_col) * mAt(inputB, row, j_col);
-
-            mAt(output, i_col, j_col) = sum;
-        }
-    }
+    gemm(mCols(inputA), mCols(inputB), mRows(inputA), 1,
+         gemm_operand_r(inputA, true), gemm_operand_r(inputB, false),
+         false, gemm_result_r(output));
 }
 
 //----------------------------------------------------------------------------
@@ -1237,19 +1555,10 @@ void ifx_mat_atb_c(const ifx_Matrix_C_t* inputA,
                      (inputB->cols != output->cols) ||
                      (inputA->rows != inputB->rows), IFX_ERROR_DIMENSION_MISMATCH)
 
-    for(uint32_t i_col = 0; i_col < inputA->cols; ++i_col)
-    {
-        for(uint32_t j_col = 0; j_col < inputB->cols; ++j_col)
-        {
-            ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
-            for(uint32_t row = 0; row < inputA->rows; ++row)
-            {
-                ifx_Complex_t tmp = ifx_complex_mul(mAt(inputA, row, i_col), mAt(inputB, row, j_col));
-                sum = ifx_complex_add(sum, tmp);
-            }
-            mAt(output, i_col, j_col) = sum;
-        }
-    }
+    gemm_complex(mCols(inputA), mCols(inputB), mRows(inputA),
+                 gemm_operand_c(inputA, true, 0), gemm_operand_c(inputA, true, 1),
+                 gemm_operand_c(inputB, false, 0), gemm_operand_c(inputB, false, 1), false,
+                 gemm_result_c(output, 0), gemm_result_c(output, 1));
 }
 
 //----------------------------------------------------------------------------
@@ -1266,19 +1575,12 @@ void ifx_mat_atb_rc(const ifx_Matrix_R_t* inputA,
                      (inputB->cols != output->cols) ||
                      (inputA->rows != inputB->rows), IFX_ERROR_DIMENSION_MISMATCH)
 
-    for(uint32_t i_col = 0; i_col < inputA->cols; ++i_col)
-    {
-        for(uint32_t j_col = 0; j_col < inputB->cols; ++j_col)
-        {
-            ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
-            for(uint32_t row = 0; row < inputA->rows; ++row)
-            {
-                ifx_Complex_t tmp = ifx_complex_mul_real(mAt(inputB, row, j_col), mAt(inputA, row, i_col));
-                sum = ifx_complex_add(sum, tmp);
-            }
-            mAt(output, i_col, j_col) = sum;
-        }
-    }
+    const gemm_operand_t no_imag = { NULL, 0, 0 };
+
+    gemm_complex(mCols(inputA), mCols(inputB), mRows(inputA),
+                 gemm_operand_r(inputA, true), no_imag,
+                 gemm_operand_c(inputB, false, 0), gemm_operand_c(inputB, false, 1), false,
+                 gemm_result_c(output, 0), gemm_result_c(output, 1));
 }
 
 //----------------------------------------------------------------------------
@@ -1295,19 +1597,12 @@ void ifx_mat_atb_cr(const ifx_Matrix_C_t* inputA,
                      (inputB->cols != output->cols) ||
                      (inputA->rows != inputB->rows), IFX_ERROR_DIMENSION_MISMATCH)
 
-    for(uint32_t i_col = 0; i_col < inputA->cols; ++i_col)
-    {
-        for(uint32_t j_col = 0; j_col < inputB->cols; ++j_col)
-        {
-            ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
-            for(uint32_t row = 0; row < inputA->rows; ++row)
-            {
-                ifx_Complex_t tmp = ifx_complex_mul_real(mAt(inputA, row, i_col), mAt(inputB, row, j_col));
-                sum = ifx_complex_add(sum, tmp);
-            }
-            mAt(output, i_col, j_col) = sum;
-        }
-    }
+    const gemm_operand_t no_imag = { NULL, 0, 0 };
+
+    gemm_complex(mCols(inputA), mCols(inputB), mRows(inputA),
+                 gemm_operand_c(inputA, true, 0), gemm_operand_c(inputA, true, 1),
+                 gemm_operand_r(inputB, false), no_imag, false,
+                 gemm_result_c(output, 0), gemm_result_c(output, 1));
 }
 
 //----------------------------------------------------------------------------
@@ -1443,22 +1738,9 @@ void ifx_mat_mul_r(const ifx_Matrix_R_t* matrix_l,
     IFX_MAT_BRK_DIM_COL(matrix_r, result);
     IFX_MAT_BRK_DIM_COL_ROW(matrix_l, matrix_r);
 
-    /* result_{jk} = (matrix_l)_{jl} * (matrix_r)_{lk} */
-
-    for (uint32_t j = 0; j < mRows(matrix_l); j++)
-    {
-        for (uint32_t k = 0; k < mCols(matrix_r); k++)
-        {
-            ifx_Float_t sum = 0;
-
-            for (uint32_t l = 0; l < mCols(matrix_l); l++)
-            {
-                sum += IFX_MAT_AT(matrix_l, j, l) * IFX_MAT_AT(matrix_r, l, k);
-            }
-
-            IFX_MAT_AT(result, j, k) = sum;
-        }
-    }
+    gemm(mRows(matrix_l), mCols(matrix_r), mCols(matrix_l), 1,
+         gemm_operand_r(matrix_l, false), gemm_operand_r(matrix_r, false),
+         false, gemm_result_r(result));
 }
 
 //----------------------------------------------------------------------------
@@ -1473,25 +1755,12 @@ void ifx_mat_mul_rc(const ifx_Matrix_R_t* matrix_l,
     IFX_MAT_BRK_DIM_ROW(matrix_l, result);
     IFX_MAT_BRK_DIM_COL(matrix_r, result);
     IFX_MAT_BRK_DIM_COL_ROW(matrix_l, matrix_r);
+    const gemm_operand_t no_imag = { NULL, 0, 0 };
 
-    /* result_{jk} = (matrix_l)_{jl} * (matrix_r)_{lk} */
-
-    for (uint32_t j = 0; j < mRows(matrix_l); j++)
-    {
-        for (uint32_t k = 0; k < mCols(matrix_r); k++)
-        {
-            ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
-
-            for (uint32_t l = 0; l < mCols(matrix_l); l++)
-            {
-                ifx_Float_t a = IFX_MAT_AT(matrix_l, j, l);
-                ifx_Complex_t b = IFX_MAT_AT(matrix_r, l, k);
-                sum = ifx_complex_add(sum, ifx_complex_mul_real(b, a));
-            }
-
-            IFX_MAT_AT(result, j, k) = sum;
-        }
-    }
+    gemm_complex(mRows(matrix_l), mCols(matrix_r), mCols(matrix_l),
+                 gemm_operand_r(matrix_l, false), no_imag,
+                 gemm_operand_c(matrix_r, false, 0), gemm_operand_c(matrix_r, false, 1), false,
+                 gemm_result_c(result, 0), gemm_result_c(result, 1));
 }
 
 //----------------------------------------------------------------------------
@@ -1507,24 +1776,10 @@ void ifx_mat_mul_c(const ifx_Matrix_C_t* matrix_l,
     IFX_MAT_BRK_DIM_COL(matrix_r, result);
     IFX_MAT_BRK_DIM_COL_ROW(matrix_l, matrix_r);
 
-    /* result_{jk} = (matrix_l)_{jl} * (matrix_r)_{lk} */
-
-    for (uint32_t j = 0; j < mRows(matrix_l); j++)
-    {
-        for (uint32_t k = 0; k < mCols(matrix_r); k++)
-        {
-            ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
-
-            for (uint32_t l = 0; l < mCols(matrix_l); l++)
-            {
-                ifx_Complex_t a = IFX_MAT_AT(matrix_l, j, l);
-                ifx_Complex_t b = IFX_MAT_AT(matrix_r, l, k);
-                sum = ifx_complex_add(sum, ifx_complex_mul(a, b));
-            }
-
-            IFX_MAT_AT(result, j, k) = sum;
-        }
-    }
+    gemm_complex(mRows(matrix_l), mCols(matrix_r), mCols(matrix_l),
+                 gemm_operand_c(matrix_l, false, 0), gemm_operand_c(matrix_l, false, 1),
+                 gemm_operand_c(matrix_r, false, 0), gemm_operand_c(matrix_r, false, 1), false,
+                 gemm_result_c(result, 0), gemm_result_c(result, 1));
 }
 
 //----------------------------------------------------------------------------
@@ -1539,25 +1794,12 @@ void ifx_mat_mul_cr(const ifx_Matrix_C_t* matrix_l,
     IFX_MAT_BRK_DIM_ROW(matrix_l, result);
     IFX_MAT_BRK_DIM_COL(matrix_r, result);
     IFX_MAT_BRK_DIM_COL_ROW(matrix_l, matrix_r);
+    const gemm_operand_t no_imag = { NULL, 0, 0 };
 
-    /* result_{jk} = (matrix_l)_{jl} * (matrix_r)_{lk} */
-
-    for (uint32_t j = 0; j < mRows(matrix_l); j++)
-    {
-        for (uint32_t k = 0; k < mCols(matrix_r); k++)
-        {
-            ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
-
-            for (uint32_t l = 0; l < mCols(matrix_l); l++)
-            {
-                ifx_Complex_t a = IFX_MAT_AT(matrix_l, j, l);
-                ifx_Float_t b = IFX_MAT_AT(matrix_r, l, k);
-                sum = ifx_complex_add(sum, ifx_complex_mul_real(a, b));
-            }
-
-            IFX_MAT_AT(result, j, k) = sum;
-        }
-    }
+    gemm_complex(mRows(matrix_l), mCols(matrix_r), mCols(matrix_l),
+                 gemm_operand_c(matrix_l, false, 0), gemm_operand_c(matrix_l, false, 1),
+                 gemm_operand_r(matrix_r, false), no_imag, false,
+                 gemm_result_c(result, 0), gemm_result_c(result, 1));
 }
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,307 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <stdbool.h>
+
+#include "ifxBase/MedianFilter.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Mem.h"
+#include "ifxBase/internal/Macros.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/* Number of values in the min heap (positions 1..) and max heap (positions
+ * -1..) for a given number of values, the median is at position 0 */
+#define MIN_COUNT(h) (((h)->count - 1) / 2)
+#define MAX_COUNT(h) ((h)->count / 2)
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+struct ifx_Median_Filter_s
+{
+    int32_t length;
+    int32_t count;          /**< Number of values in the window */
+    int32_t next;           /**< Ring buffer slot of the next value */
+
+    ifx_Float_t* values;    /**< Ring buffer of the window */
+    int32_t* position;      /**< Heap position of every ring buffer slot */
+    int32_t* heap;          /**< Ring buffer slot at every heap position, indexed from
+                                 -length/2 to length/2. Children of position i are 2i
+                                 and 2i+1 in the min heap, 2i and 2i-1 in the max heap. */
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static inline bool less(const ifx_Median_Filter_t* h, int32_t i, int32_t j);
+
+static inline void exchange(ifx_Median_Filter_t* h, int32_t i, int32_t j);
+
+static inline bool order(ifx_Median_Filter_t* h, int32_t i, int32_t j);
+
+static void min_sort_down(ifx_Median_Filter_t* h, int32_t i);
+
+static void max_sort_down(ifx_Median_Filter_t* h, int32_t i);
+
+static bool min_sort_up(ifx_Median_Filter_t* h, int32_t i);
+
+static bool max_sort_up(ifx_Median_Filter_t* h, int32_t i);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static inline bool less(const ifx_Median_Filter_t* h, int32_t i, int32_t j)
+{
+    return h->values[h->heap[i]] < h->values[h->heap[j]];
+}
+
+//----------------------------------------------------------------------------
+
+static inline void exchange(ifx_Median_Filter_t* h, int32_t i, int32_t j)
+{
+    const int32_t t = h->heap[i];
+    h->heap[i] = h->heap[j];
+    h->heap[j] = t;
+    h->position[h->heap[i]] = i;
+    h->position[h->heap[j]] = j;
+}
+
+//----------------------------------------------------------------------------
+
+/* Swaps positions i and j if the value at i is smaller */
+static inline bool order(ifx_Median_Filter_t* h, int32_t i, int32_t j)
+{
+    if (!less(h, i, j))
+        return false;
+
+    exchange(h, i, j);
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+static void min_sort_down(ifx_Median_Filter_t* h, int32_t i)
+{
+    for (i *= 2; i <= MIN_COUNT(h); i *= 2)
+    {
+        if ((i < MIN_COUNT(h)) && less(h, i + 1, i))
+            i++;
+        if (!order(h, i, i / 2))
+            break;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void max_sort_down(ifx_Median_Filter_t* h, int32_t i)
+{
+    for (i *= 2; i >= -MAX_COUNT(h); i *= 2)
+    {
+        if ((i > -MAX_COUNT(h)) && less(h, i, i - 1))
+            i--;
+        if (!order(h, i / 2, i))
+            break;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/* Returns true if the value reached the median position */
+static bool min_sort_up(ifx_Median_Filter_t* h, int32_t i)
+{
+    while ((i > 0) && order(h, i, i / 2))
+        i /= 2;
+    return i == 0;
+}
+
+//----------------------------------------------------------------------------
+
+static bool max_sort_up(ifx_Median_Filter_t* h, int32_t i)
+{
+    while ((i < 0) && order(h, i / 2, i))
+        i /= 2;
+    return i == 0;
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Median_Filter_t* ifx_median_filter_create(uint32_t window_length)
+{
+    IFX_ERR_BRN_ARGUMENT((window_length == 0) || (window_length > (1u << 30)));
+
+    ifx_Median_Filter_t* h = ifx_mem_calloc(1, sizeof(ifx_Median_Filter_t));
+    IFX_ERR_BRN_MEMALLOC(h);
+
+    h->length = (int32_t)window_length;
+    h->values = ifx_mem_calloc(window_length, sizeof(ifx_Float_t));
+    h->position = ifx_mem_calloc(window_length, sizeof(int32_t));
+    h->heap = ifx_mem_calloc(window_length, sizeof(int32_t));
+
+    if (!h->values || !h->position || !h->heap)
+    {
+        ifx_median_filter_destroy(h);
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return NULL;
+    }
+
+    ifx_median_filter_reset(h);
+    return h;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_median_filter_destroy(ifx_Median_Filter_t* handle)
+{
+    if (handle == NULL)
+        return;
+
+    ifx_mem_free(handle->values);
+    ifx_mem_free(handle->position);
+    ifx_mem_free(handle->heap);
+    ifx_mem_free(handle);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_median_filter_reset(ifx_Median_Filter_t* handle)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    int32_t* heap = handle->heap + handle->length / 2;
+
+    handle->count = 0;
+    handle->next = 0;
+
+    // slots are assigned alternately to the max and min heap, so the heaps
+    // stay balanced while the window fills up
+    for (int32_t slot = 0; slot < handle->length; slot++)
+    {
+        const int32_t position = ((slot + 1) / 2) * ((slot & 1) ? -1 : 1);
+        handle->position[slot] = position;
+        heap[position] = slot;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Float_t ifx_median_filter_run(ifx_Median_Filter_t* handle,
+                                  ifx_Float_t value)
+{
+    IFX_ERR_BRV_NULL(handle, IFX_NAN);
+
+    // the heap is addressed relative to the median position
+    ifx_Median_Filter_t h = *handle;
+    h.heap = handle->heap + handle->length / 2;
+
+    const bool is_new = (h.count < h.length);
+    const int32_t slot = h.next;
+    const int32_t p = h.position[slot];
+    const ifx_Float_t old = h.values[slot];
+
+    h.values[slot] = value;
+    h.next = (slot + 1 == h.length) ? 0 : slot + 1;
+    h.count += is_new;
+
+    if (p > 0)
+    {
+        if (!is_new && (old < value))
+            min_sort_down(&h, p);
+        else if (min_sort_up(&h, p) && order(&h, 0, -1))
+            max_sort_down(&h, -1);
+    }
+    else if (p < 0)
+    {
+        if (!is_new && (value < old))
+            max_sort_down(&h, p);
+        else if (max_sort_up(&h, p) && (MIN_COUNT(&h) > 0) && order(&h, 1, 0))
+            min_sort_down(&h, 1);
+    }
+    else
+    {
+        // the median slot itself changed, it may belong to either heap
+        if ((MAX_COUNT(&h) > 0) && order(&h, 0, -1))
+            max_sort_down(&h, -1);
+        if ((MIN_COUNT(&h) > 0) && order(&h, 1, 0))
+            min_sort_down(&h, 1);
+    }
+
+    handle->count = h.count;
+    handle->next = h.next;
+
+    ifx_Float_t median = h.values[h.heap[0]];
+    if ((h.count & 1) == 0)
+        median = (median + h.values[h.heap[-1]]) / 2;
+
+    return median;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_median_filter_run_vec(ifx_Median_Filter_t* handle,
+                               const ifx_Vector_R_t* input,
+                               ifx_Vector_R_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_VEC_BRK_VALID(input);
+    IFX_VEC_BRK_VALID(output);
+    IFX_ERR_BRK_COND(vLen(input) != vLen(output), IFX_ERROR_DIMENSION_MISMATCH);
+
+    for (uint32_t i = 0; i < vLen(input); i++)
+        vAt(output, i) = ifx_median_filter_run(handle, vAt(input, i));
+}
@@ -0,0 +1,166 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file MedianFilter.h
+ *
+ * \brief \copybrief gr_median_filter
+ *
+ * For details refer to \ref gr_median_filter
+ */
+
+#ifndef IFX_BASE_MEDIAN_FILTER_H
+#define IFX_BASE_MEDIAN_FILTER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Defines.h"
+#include "ifxBase/Types.h"
+#include "ifxBase/Vector.h"
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Forward declaration structure for a sliding median filter.
+ */
+typedef struct ifx_Median_Filter_s ifx_Median_Filter_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_SDK_base
+  * @{
+  */
+
+/** @defgroup gr_median_filter Median Filter
+  * @brief API for medians over a sliding window
+  *
+  * The filter keeps the last window_length values of a stream, e.g. one
+  * range bin over chirps or frames, and returns their median after every
+  * new value. Until the window is filled the median of the values so far is
+  * returned; for an even number of values it is the mean of the two middle
+  * ones.
+  *
+  * The window is kept in two heaps sharing one array, a max heap of the
+  * smaller half and a min heap of the larger half with the median between
+  * them. Every heap entry knows the ring buffer slot of its value and vice
+  * versa, so the oldest value is replaced in place and each update costs
+  * O(log window_length) instead of sorting the window.
+  *
+  * @{
+  */
+
+/**
+ * @brief Creates a sliding median filter.
+ *
+ * @param [in]     window_length Number of values in the window, at least 1.
+ *
+ * @return Handle to the filter, NULL in case of an error.
+ */
+IFX_DLL_PUBLIC
+ifx_Median_Filter_t* ifx_median_filter_create(uint32_t window_length);
+
+/**
+ * @brief Destroys a sliding median filter.
+ *
+ * @param [in]     handle    Filter to destroy, may be NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_median_filter_destroy(ifx_Median_Filter_t* handle);
+
+/**
+ * @brief Empties the window.
+ *
+ * @param [in]     handle    Filter.
+ */
+IFX_DLL_PUBLIC
+void ifx_median_filter_reset(ifx_Median_Filter_t* handle);
+
+/**
+ * @brief Adds a value to the window and returns the median of the window.
+ *
+ * @param [in]     handle    Filter.
+ * @param [in]     value     New value, replaces the oldest one once the
+ *                           window is full.
+ *
+ * @return Median of the window, NaN in case of an error.
+ */
+IFX_DLL_PUBLIC
+ifx_Float_t ifx_median_filter_run(ifx_Median_Filter_t* handle,
+                                  ifx_Float_t value);
+
+/**
+ * @brief Adds all values of a vector in order and stores the median after
+ *        each of them.
+ *
+ * @param [in]     handle    Filter.
+ * @param [in]     input     Values to add.
+ * @param [out]    output    Medians, same length as the input, may be the
+ *                           input itself.
+ */
+IFX_DLL_PUBLIC
+void ifx_median_filter_run_vec(ifx_Median_Filter_t* handle,
+                               const ifx_Vector_R_t* input,
+                               ifx_Vector_R_t* output);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif /* IFX_BASE_MEDIAN_FILTER_H */
@@ -0,0 +1,257 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/RangeDoppler.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/FFT.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Mem.h"
+#include "ifxBase/internal/Macros.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+struct ifx_RDM_s
+{
+    uint32_t num_samples;
+    uint32_t num_chirps;
+    uint32_t num_antennas;
+    uint32_t num_range_bins;
+
+    ifx_FFT_t* range_fft;
+    ifx_FFT_t* doppler_fft;
+
+    /** Product of range and Doppler window per sample and chirp, including
+     *  the sign changes of the Doppler shift. NULL if nothing is applied. */
+    ifx_Float_t* window;
+
+    ifx_Cube_R_t* windowed;     /**< [sample][antenna][chirp] */
+    ifx_Cube_C_t* range;        /**< [range bin][antenna][chirp] */
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static uint32_t fft_size_for(uint32_t requested, uint32_t length);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static uint32_t fft_size_for(uint32_t requested, uint32_t length)
+{
+    if (requested != 0)
+        return requested;
+
+    uint32_t size = 1;
+    while (size < length)
+        size *= 2;
+    return size;
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_RDM_t* ifx_rdm_create(const ifx_RDM_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_ARGUMENT((config->num_samples_per_chirp == 0) ||
+                         (config->num_chirps_per_frame == 0) ||
+                         (config->num_antennas == 0));
+    IFX_ERR_BRN_ARGUMENT(config->range_window &&
+                         (vLen(config->range_window) != config->num_samples_per_chirp));
+    IFX_ERR_BRN_ARGUMENT(config->doppler_window &&
+                         (vLen(config->doppler_window) != config->num_chirps_per_frame));
+
+    const uint32_t range_fft_size = fft_size_for(config->range_fft_size, config->num_samples_per_chirp);
+    const uint32_t doppler_fft_size = fft_size_for(config->doppler_fft_size, config->num_chirps_per_frame);
+    IFX_ERR_BRN_ARGUMENT((range_fft_size < 2) || (range_fft_size < config->num_samples_per_chirp));
+    IFX_ERR_BRN_ARGUMENT(doppler_fft_size < config->num_chirps_per_frame);
+
+    ifx_RDM_t* handle = ifx_mem_calloc(1, sizeof(ifx_RDM_t));
+    IFX_ERR_BRN_MEMALLOC(handle);
+
+    handle->num_samples = config->num_samples_per_chirp;
+    handle->num_chirps = config->num_chirps_per_frame;
+    handle->num_antennas = config->num_antennas;
+    handle->num_range_bins = range_fft_size / 2;
+
+    handle->range_fft = ifx_fft_create(IFX_FFT_TYPE_R2C, range_fft_size);
+    handle->doppler_fft = ifx_fft_create(IFX_FFT_TYPE_C2C, doppler_fft_size);
+    handle->windowed = ifx_cube_create_r(handle->num_antennas, handle->num_chirps, handle->num_samples);
+    handle->range = ifx_cube_create_c(handle->num_antennas, handle->num_chirps, handle->num_range_bins);
+
+    const bool windowed = config->range_window || config->doppler_window || config->doppler_fftshift;
+    if (windowed)
+        handle->window = ifx_mem_aligned_alloc((size_t)handle->num_samples * handle->num_chirps * sizeof(ifx_Float_t),
+                                               MEMORY_ALIGNMENT);
+
+    if (!handle->range_fft || !handle->doppler_fft || !handle->windowed || !handle->range ||
+        (windowed && !handle->window))
+    {
+        ifx_rdm_destroy(handle);
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return NULL;
+    }
+
+    // both windows are separable, so they are applied as one table. Negating
+    // every other chirp shifts the Doppler spectrum by half its size.
+    for (uint32_t s = 0; windowed && (s < handle->num_samples); s++)
+    {
+        const ifx_Float_t ws = config->range_window ? vAt(config->range_window, s) : 1;
+
+        for (uint32_t c = 0; c < handle->num_chirps; c++)
+        {
+            ifx_Float_t w = ws * (config->doppler_window ? vAt(config->doppler_window, c) : 1);
+            if (config->doppler_fftshift && (c & 1))
+                w = -w;
+            handle->window[(size_t)s * handle->num_chirps + c] = w;
+        }
+    }
+
+    return handle;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_rdm_destroy(ifx_RDM_t* handle)
+{
+    if (handle == NULL)
+        return;
+
+    ifx_fft_destroy(handle->range_fft);
+    ifx_fft_destroy(handle->doppler_fft);
+    ifx_mem_aligned_free(handle->window);
+    ifx_cube_destroy_r(handle->windowed);
+    ifx_cube_destroy_c(handle->range);
+    ifx_mem_free(handle);
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_rdm_get_num_range_bins(const ifx_RDM_t* handle)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+
+    return handle->num_range_bins;
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_rdm_get_num_doppler_bins(const ifx_RDM_t* handle)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+
+    return ifx_fft_get_fft_size(handle->doppler_fft);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_rdm_run(ifx_RDM_t* handle,
+                 const ifx_Cube_R_t* frame,
+                 ifx_Cube_C_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(frame);
+    IFX_ERR_BRK_NULL(output);
+    IFX_ERR_BRK_COND((cSlices(frame) != handle->num_samples) ||
+                     (cRows(frame) != handle->num_antennas) ||
+                     (cCols(frame) != handle->num_chirps), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND((cSlices(output) != handle->num_antennas) ||
+                     (cRows(output) != handle->num_range_bins) ||
+                     (cCols(output) != ifx_fft_get_fft_size(handle->doppler_fft)), IFX_ERROR_DIMENSION_MISMATCH);
+
+    const uint32_t num_antennas = handle->num_antennas;
+    const uint32_t num_chirps = handle->num_chirps;
+    const ifx_Cube_R_t* input = frame;
+
+    if (handle->window != NULL)
+    {
+        for (uint32_t s = 0; s < handle->num_samples; s++)
+        {
+            const ifx_Float_t* w = handle->window + (size_t)s * num_chirps;
+
+            for (uint32_t a = 0; a < num_antennas; a++)
+            {
+                const ifx_Float_t* src = &cAt(frame, a, 0, s);
+                ifx_Float_t* dst = &cAt(handle->windowed, a, 0, s);
+
+                for (uint32_t c = 0; c < num_chirps; c++)
+                    dst[c] = src[c] * w[c];
+            }
+        }
+        input = handle->windowed;
+    }
+
+    // range FFT of every chirp, bin k of all chirps of an antenna ends up in
+    // one contiguous row of the intermediate cube
+    ifx_fft_run_rc_cube(handle->range_fft, input, handle->range);
+
+    // the rows of one antenna are num_antennas rows apart
+    for (uint32_t a = 0; a < num_antennas; a++)
+    {
+        ifx_Matrix_C_t range_rows;
+        ifx_Matrix_C_t map;
+
+        ifx_mat_rawview_c(&range_rows, &cAt(handle->range, a, 0, 0),
+                          handle->num_range_bins, num_chirps, num_antennas * num_chirps);
+        ifx_cube_get_slice_c(output, a, &map);
+
+        ifx_fft_run_c_rows(handle->doppler_fft, &range_rows, &map);
+    }
+}
@@ -0,0 +1,175 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file RangeDoppler.h
+ *
+ * \brief \copybrief gr_range_doppler
+ *
+ * For details refer to \ref gr_range_doppler
+ */
+
+#ifndef IFX_BASE_RANGE_DOPPLER_H
+#define IFX_BASE_RANGE_DOPPLER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <stdbool.h>
+
+#include "ifxBase/Cube.h"
+#include "ifxBase/Defines.h"
+#include "ifxBase/Types.h"
+#include "ifxBase/Vector.h"
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Configuration of a range-Doppler map stage.
+ */
+typedef struct
+{
+    uint32_t num_samples_per_chirp;         /**< Samples per chirp of the input frames */
+    uint32_t num_chirps_per_frame;          /**< Chirps per frame of the input frames */
+    uint32_t num_antennas;                  /**< Antennas of the input frames */
+    uint32_t range_fft_size;                /**< Power of 2, 0 for the smallest one holding all samples */
+    uint32_t doppler_fft_size;              /**< Power of 2, 0 for the smallest one holding all chirps */
+    const ifx_Vector_R_t* range_window;     /**< num_samples_per_chirp coefficients, e.g. from ifx_window_get(), NULL for none */
+    const ifx_Vector_R_t* doppler_window;   /**< num_chirps_per_frame coefficients, NULL for none */
+    bool doppler_fftshift;                  /**< Move zero Doppler to column doppler_fft_size / 2 */
+} ifx_RDM_Config_t;
+
+/**
+ * @brief Forward declaration structure for a range-Doppler map stage.
+ */
+typedef struct ifx_RDM_s ifx_RDM_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_SDK_base
+  * @{
+  */
+
+/** @defgroup gr_range_doppler Range Doppler Map
+  * @brief API for computing range-Doppler maps of radar frames
+  *
+  * Input frames are real cubes with the layout [sample][antenna][chirp] as
+  * delivered by the acquisition. The output holds one range-Doppler map per
+  * antenna: slice a of the output cube is the map of antenna a with
+  * range_fft_size / 2 rows (range bins) and doppler_fft_size columns
+  * (Doppler bins).
+  *
+  * Both windows are applied in a single pass over the frame. The range FFT
+  * of all chirps then produces range bins with the chirps of every antenna
+  * in consecutive memory, so the Doppler FFTs read contiguous rows instead
+  * of strided columns. All intermediate buffers belong to the stage and are
+  * reused for every frame.
+  *
+  * @{
+  */
+
+/**
+ * @brief Creates a range-Doppler map stage.
+ *
+ * @param [in]     config    Configuration, the windows are copied.
+ *
+ * @return Handle to the stage, NULL in case of an error.
+ */
+IFX_DLL_PUBLIC
+ifx_RDM_t* ifx_rdm_create(const ifx_RDM_Config_t* config);
+
+/**
+ * @brief Destroys a range-Doppler map stage.
+ *
+ * @param [in]     handle    Stage to destroy, may be NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_rdm_destroy(ifx_RDM_t* handle);
+
+/**
+ * @brief Returns the number of range bins of the computed maps.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_rdm_get_num_range_bins(const ifx_RDM_t* handle);
+
+/**
+ * @brief Returns the number of Doppler bins of the computed maps.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_rdm_get_num_doppler_bins(const ifx_RDM_t* handle);
+
+/**
+ * @brief Computes the range-Doppler maps of a frame.
+ *
+ * @param [in]     handle    Stage.
+ * @param [in]     frame     Frame with num_samples_per_chirp slices,
+ *                           num_antennas rows and num_chirps_per_frame columns.
+ * @param [out]    output    Cube with num_antennas slices, range bins rows and
+ *                           Doppler bins columns.
+ */
+IFX_DLL_PUBLIC
+void ifx_rdm_run(ifx_RDM_t* handle,
+                 const ifx_Cube_R_t* frame,
+                 ifx_Cube_C_t* output);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif /* IFX_BASE_RANGE_DOPPLER_H */
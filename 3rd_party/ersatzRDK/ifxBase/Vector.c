@@ -42,6 +42,7 @@
 #include "ifxBase/Error.h"
 #include "ifxBase/Defines.h"
 #include "ifxBase/internal/Macros.h"
+#include "ifxBase/internal/Simd.h"
 #include "ifxBase/internal/Util.h"
 
 /*
@@ -50,14 +51,25 @@
 ==============================================================================
 */
 
-#define IFX_COMPARE_FUNCTION(FN_NAME, TYPE)          \
-    int FN_NAME(void* h, uint32_t ia, uint32_t ib) { \
-        TYPE a = ((TYPE*)h)[ia];                     \
-        TYPE b = ((TYPE*)h)[ib];                     \
-        if(a > b) return 1;                          \
-        if(a < b) return -1;                         \
-        return 0;                                    \
-    }
+/* Ranges up to this length are selected from a copy on the stack */
+#define SELECT_STACK_SIZE 256
+
+/* Ranges up to this length are finished by insertion sort */
+#define SELECT_SMALL 16
+
+/* Index sorts up to this length use insertion sort instead of radix sort */
+#define SORT_SMALL 64
+
+/* Radix sort of the 32 bit keys in 3 passes of 11 bits */
+#define SORT_RADIX_BITS 11
+#define SORT_RADIX_SIZE (1u << SORT_RADIX_BITS)
+#define SORT_RADIX_PASSES 3
+
+/* Top k selections up to this k keep their heap on the stack */
+#define SORT_TOPK_STACK_SIZE 256
+
+/* 10 * log10(x) = DB_PER_LOG2 * log2(x) */
+#define DB_PER_LOG2 3.01029996f
 
 /*
 ==============================================================================
@@ -88,47 +100,57 @@ typedef struct Vector_alloc_params
 ==============================================================================
 */
 
-static void ssort(void* handle,
-                  uint32_t count,
-                  int (*compare)(void* handle, uint32_t ia, uint32_t ib),
-                  ifx_Vector_Sort_Order_t order,
-                  uint32_t* array);
+/**
+ * @brief Returns the sort key of a vector element in the upper 32 bits and
+ *        its index in the lower 32 bits.
+ *
+ * The float bits are mapped to an unsigned integer with the same order
+ * (negative values have all bits flipped, positive ones the sign bit) and
+ * inverted for descending order. As the index breaks ties, comparing the
+ * packed values gives the order of a stable sort.
+ */
+static inline uint64_t sort_key(const ifx_Vector_R_t* input, uint32_t index,
+                                ifx_Vector_Sort_Order_t order);
 
-static IFX_COMPARE_FUNCTION(float_compare, ifx_Float_t);
+static void sort_keys_insertion(uint64_t* keys, uint32_t count);
 
+/**
+ * @brief Sorts packed keys from \ref sort_key by their upper 32 bits.
+ *
+ * LSD radix sort, stable, so equal keys stay in index order. Passes in
+ * which all keys share the same digit are skipped. Returns the buffer
+ * holding the result, either keys or scratch.
+ */
+static uint64_t* sort_keys_radix(uint64_t* keys, uint64_t* scratch, uint32_t count);
+
+static void sort_keys_sift_down(uint64_t* heap, uint32_t count, uint32_t root);
+
+
+/**
+ * @brief Rearranges values so that values[k] is the value of rank k (from
+ *        0), values before it are not greater and values after it are not
+ *        smaller.
+ *
+ * Introselect: quickselect with median of three pivots, which falls back
+ * to heapsort of the remaining range if the partitions don't shrink fast
+ * enough, so the worst case stays O(n log n) while the typical case is O(n).
+ *
+ * @param [in,out] values    values to rearrange
+ * @param [in]     count     number of values
+ * @param [in]     k         rank to select, less than count
+ */
+static void select_nth(ifx_Float_t* values, uint32_t count, uint32_t k);
+
+static void heapsort_range(ifx_Float_t* values, uint32_t count);
 
 /**
- * @brief Computes number of higher and lower elements in array for given position.
- *        It takes into consideration element on index pick_pos_offsetted+offset 
- *        as a base for comparison.
- * 
- * Special cases in counting elements:<br>
- * 1) If value is equal and is before pick_pos_offsetted -1 is added.<br/>
- * 2) If value is equal and is after pick_pos_offsetted -1 is added.<br/>
- * Important is that this function return 0 if is median and number of elements is odd
- * -1 or 1 if number of elements is even for values that directly betwean.
- * 
- * /code 
- * Example
- *   input = {3, 2, 1, 7}
- * for pick_pos_offsetted = 1 (value = 2); offset = 0; number_of_el = 4
- *   3, 7 > 2 so +2
- *   1 < 2 so -1
- * Result is +2-1=1
- * /endcode
- * 
- * @param [in]     input            buffer that is used to compute rank
- * @param [in]     offset           start position of computation
- * @param [in]     number_of_el     number of elements to compute rank
- * 
- * @param [in]     pick_pos_offsetted       on this position (offset+pick_pos_offsetted) 
- *                                          is element to compute rank (it is excluded
- *                                          from rank)
- * @retval a rank value
+ * @brief Copies a range of a vector into contiguous memory for selection.
+ *
+ * Uses buffer if the range fits, otherwise allocates memory which must be
+ * freed with ifx_mem_free if it differs from buffer.
  */
-static int median_rank(
-    const ifx_Vector_R_t* input, uint32_t offset, 
-    uint32_t number_of_el, uint32_t pick_pos_offsetted);
+static ifx_Float_t* copy_range(const ifx_Vector_R_t* input, uint32_t offset, uint32_t length,
+                               ifx_Float_t* buffer);
 
 /**
  * @brief Computes the required memory size (in bytes) for vector and checks for overflows
@@ -150,51 +172,347 @@ static int median_rank(
  */
 static bool vector_alloc_size_overflow(size_t length, size_t elem_size, size_t data_offset, size_t* alloc_size);
 
+/*
+ * Kernels for contiguous vectors. Complex data is interleaved (re, im), n
+ * counts complex values. Four values are processed per iteration, the
+ * output may alias an input.
+ */
+static void kernel_add(const ifx_Float_t* a, const ifx_Float_t* b, ifx_Float_t* r, uint32_t n);
+static void kernel_sub(const ifx_Float_t* a, const ifx_Float_t* b, ifx_Float_t* r, uint32_t n);
+static void kernel_scale(const ifx_Float_t* a, ifx_Float_t s, ifx_Float_t* r, uint32_t n);
+static void kernel_cmul(const ifx_Float_t* a, const ifx_Float_t* b, ifx_Float_t* r, uint32_t n);
+static void kernel_cmul_real(const ifx_Float_t* a, const ifx_Float_t* b, ifx_Float_t* r, uint32_t n);
+static void kernel_cscale(const ifx_Float_t* a, ifx_Complex_t s, ifx_Float_t* r, uint32_t n);
+static void kernel_cmac(const ifx_Float_t* a, const ifx_Float_t* b, ifx_Complex_t s, ifx_Float_t* r, uint32_t n);
+static void kernel_cabs(const ifx_Float_t* a, ifx_Float_t* r, uint32_t n);
+static void kernel_csqnorm_db(const ifx_Float_t* a, ifx_Float_t* r, uint32_t n);
+static ifx_Float_t kernel_csqsum(const ifx_Float_t* a, uint32_t n);
+static void kernel_interleave(const ifx_Float_t* re, const ifx_Float_t* im, ifx_Float_t* r, uint32_t n);
+static void kernel_deinterleave(const ifx_Float_t* a, ifx_Float_t* re, ifx_Float_t* im, uint32_t n);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
 ==============================================================================
 */
 
-static void ssort(void* handle,
-                  uint32_t count,
-                  int (*compare)(void* handle, uint32_t ia, uint32_t ib),
-                  ifx_Vector_Sort_Order_t order,
-                  uint32_t* array)
+static void kernel_add(const ifx_Float_t* a, const ifx_Float_t* b, ifx_Float_t* r, uint32_t n)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        v4_storeu(r + i, v4_add(v4_loadu(a + i), v4_loadu(b + i)));
+    for (; i < n; i++)
+        r[i] = a[i] + b[i];
+}
+
+//----------------------------------------------------------------------------
+
+static void kernel_sub(const ifx_Float_t* a, const ifx_Float_t* b, ifx_Float_t* r, uint32_t n)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        v4_storeu(r + i, v4_sub(v4_loadu(a + i), v4_loadu(b + i)));
+    for (; i < n; i++)
+        r[i] = a[i] - b[i];
+}
+
+//----------------------------------------------------------------------------
+
+static void kernel_scale(const ifx_Float_t* a, ifx_Float_t s, ifx_Float_t* r, uint32_t n)
+{
+    const v4_t vs = v4_set1(s);
+
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        v4_storeu(r + i, v4_mul(v4_loadu(a + i), vs));
+    for (; i < n; i++)
+        r[i] = a[i] * s;
+}
+
+//----------------------------------------------------------------------------
+
+static void kernel_cmul(const ifx_Float_t* a, const ifx_Float_t* b, ifx_Float_t* r, uint32_t n)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        v4_t are, aim, bre, bim;
+        v4_load_deinterleaved(a + 2 * i, &are, &aim);
+        v4_load_deinterleaved(b + 2 * i, &bre, &bim);
+
+        const v4_t re = v4_sub(v4_mul(are, bre), v4_mul(aim, bim));
+        const v4_t im = v4_madd(v4_mul(are, bim), aim, bre);
+        v4_store_interleaved(r + 2 * i, re, im);
+    }
+    for (; i < n; i++)
+    {
+        const ifx_Float_t are = a[2 * i], aim = a[2 * i + 1];
+        const ifx_Float_t bre = b[2 * i], bim = b[2 * i + 1];
+        r[2 * i] = are * bre - aim * bim;
+        r[2 * i + 1] = are * bim + aim * bre;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void kernel_cmul_real(const ifx_Float_t* a, const ifx_Float_t* b, ifx_Float_t* r, uint32_t n)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        v4_t are, aim;
+        v4_load_deinterleaved(a + 2 * i, &are, &aim);
+
+        const v4_t vb = v4_loadu(b + i);
+        v4_store_interleaved(r + 2 * i, v4_mul(are, vb), v4_mul(aim, vb));
+    }
+    for (; i < n; i++)
+    {
+        r[2 * i] = a[2 * i] * b[i];
+        r[2 * i + 1] = a[2 * i + 1] * b[i];
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void kernel_cscale(const ifx_Float_t* a, ifx_Complex_t s, ifx_Float_t* r, uint32_t n)
+{
+    const ifx_Float_t sre = IFX_COMPLEX_REAL(s);
+    const ifx_Float_t sim = IFX_COMPLEX_IMAG(s);
+    const v4_t vsre = v4_set1(sre);
+    const v4_t vsim = v4_set1(sim);
+
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        v4_t are, aim;
+        v4_load_deinterleaved(a + 2 * i, &are, &aim);
+
+        const v4_t re = v4_sub(v4_mul(are, vsre), v4_mul(aim, vsim));
+        const v4_t im = v4_madd(v4_mul(are, vsim), aim, vsre);
+        v4_store_interleaved(r + 2 * i, re, im);
+    }
+    for (; i < n; i++)
+    {
+        const ifx_Float_t are = a[2 * i], aim = a[2 * i + 1];
+        r[2 * i] = are * sre - aim * sim;
+        r[2 * i + 1] = are * sim + aim * sre;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void kernel_cmac(const ifx_Float_t* a, const ifx_Float_t* b, ifx_Complex_t s, ifx_Float_t* r, uint32_t n)
+{
+    const ifx_Float_t sre = IFX_COMPLEX_REAL(s);
+    const ifx_Float_t sim = IFX_COMPLEX_IMAG(s);
+    const v4_t vsre = v4_set1(sre);
+    const v4_t vsim = v4_set1(sim);
+
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        v4_t are, aim, bre, bim;
+        v4_load_deinterleaved(a + 2 * i, &are, &aim);
+        v4_load_deinterleaved(b + 2 * i, &bre, &bim);
+
+        const v4_t re = v4_add(are, v4_sub(v4_mul(bre, vsre), v4_mul(bim, vsim)));
+        const v4_t im = v4_add(aim, v4_madd(v4_mul(bre, vsim), bim, vsre));
+        v4_store_interleaved(r + 2 * i, re, im);
+    }
+    for (; i < n; i++)
+    {
+        const ifx_Float_t bre = b[2 * i], bim = b[2 * i + 1];
+        r[2 * i] = a[2 * i] + (bre * sre - bim * sim);
+        r[2 * i + 1] = a[2 * i + 1] + (bre * sim + bim * sre);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void kernel_cabs(const ifx_Float_t* a, ifx_Float_t* r, uint32_t n)
 {
-    uint32_t gaps[] = {701, 301, 132, 57, 23, 10, 4, 1}; //tbd
-    uint32_t num_gaps = sizeof(gaps) / sizeof(gaps[0]);
-    int ord = order == IFX_SORT_DESCENDING ? -1 : 1;
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        v4_t re, im;
+        v4_load_deinterleaved(a + 2 * i, &re, &im);
+        v4_storeu(r + i, v4_sqrt(v4_madd(v4_mul(re, re), im, im)));
+    }
+    for (; i < n; i++)
+        r[i] = SQRT(a[2 * i] * a[2 * i] + a[2 * i + 1] * a[2 * i + 1]);
+}
+
+//----------------------------------------------------------------------------
+
+static void kernel_csqnorm_db(const ifx_Float_t* a, ifx_Float_t* r, uint32_t n)
+{
+    const v4_t scale = v4_set1(DB_PER_LOG2);
+
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        v4_t re, im;
+        v4_load_deinterleaved(a + 2 * i, &re, &im);
+        v4_storeu(r + i, v4_mul(scale, v4_log2(v4_madd(v4_mul(re, re), im, im))));
+    }
+    for (; i < n; i++)
+        r[i] = DB_PER_LOG2 * ifx_simd_log2(a[2 * i] * a[2 * i] + a[2 * i + 1] * a[2 * i + 1]);
+}
+
+//----------------------------------------------------------------------------
+
+static ifx_Float_t kernel_csqsum(const ifx_Float_t* a, uint32_t n)
+{
+    // two independent accumulators over 8 floats hide the add latency
+    v4_t acc0 = v4_set1(0);
+    v4_t acc1 = v4_set1(0);
+
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const v4_t x0 = v4_loadu(a + 2 * i);
+        const v4_t x1 = v4_loadu(a + 2 * i + 4);
+        acc0 = v4_madd(acc0, x0, x0);
+        acc1 = v4_madd(acc1, x1, x1);
+    }
+
+    ifx_Float_t lanes[4];
+    v4_storeu(lanes, v4_add(acc0, acc1));
+    ifx_Float_t result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+    for (; i < n; i++)
+        result += a[2 * i] * a[2 * i] + a[2 * i + 1] * a[2 * i + 1];
+
+    return result;
+}
+
+//----------------------------------------------------------------------------
+
+static void kernel_interleave(const ifx_Float_t* re, const ifx_Float_t* im, ifx_Float_t* r, uint32_t n)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        v4_store_interleaved(r + 2 * i, v4_loadu(re + i), v4_loadu(im + i));
+    for (; i < n; i++)
+    {
+        r[2 * i] = re[i];
+        r[2 * i + 1] = im[i];
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void kernel_deinterleave(const ifx_Float_t* a, ifx_Float_t* re, ifx_Float_t* im, uint32_t n)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        v4_t vre, vim;
+        v4_load_deinterleaved(a + 2 * i, &vre, &vim);
+        v4_storeu(re + i, vre);
+        v4_storeu(im + i, vim);
+    }
+    for (; i < n; i++)
+    {
+        re[i] = a[2 * i];
+        im[i] = a[2 * i + 1];
+    }
+}
+
+//----------------------------------------------------------------------------
 
+static inline uint64_t sort_key(const ifx_Vector_R_t* input, uint32_t index,
+                                ifx_Vector_Sort_Order_t order)
+{
+    union { ifx_Float_t f; uint32_t u; } value = { vAt(input, index) };
+
+    uint32_t key = value.u ^ ((value.u >> 31) ? 0xFFFFFFFFu : 0x80000000u);
+    if (order == IFX_SORT_DESCENDING)
+        key = ~key;
+
+    return ((uint64_t)key << 32) | index;
+}
+
+//----------------------------------------------------------------------------
+
+static void sort_keys_insertion(uint64_t* keys, uint32_t count)
+{
+    for (uint32_t i = 1; i < count; i++)
+    {
+        const uint64_t key = keys[i];
+        uint32_t j = i;
+        for (; (j > 0) && (key < keys[j - 1]); j--)
+            keys[j] = keys[j - 1];
+        keys[j] = key;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static uint64_t* sort_keys_radix(uint64_t* keys, uint64_t* scratch, uint32_t count)
+{
+    uint32_t histogram[SORT_RADIX_PASSES][SORT_RADIX_SIZE] = { { 0 } };
+
+    // one pass over the keys counts the digits for all passes
     for (uint32_t i = 0; i < count; i++)
     {
-        array[i] = i;
+        const uint32_t key = (uint32_t)(keys[i] >> 32);
+        for (uint32_t pass = 0; pass < SORT_RADIX_PASSES; pass++)
+            histogram[pass][(key >> (pass * SORT_RADIX_BITS)) & (SORT_RADIX_SIZE - 1)]++;
     }
 
-    for (uint32_t g = 0; g < num_gaps; g++)
+    uint64_t* src = keys;
+    uint64_t* dst = scratch;
+
+    for (uint32_t pass = 0; pass < SORT_RADIX_PASSES; pass++)
     {
-        uint32_t gap = gaps[g];
+        uint32_t* offset = histogram[pass];
+        const uint32_t shift = 32 + pass * SORT_RADIX_BITS;
 
-        if (gap > count)
-        {
+        if (offset[(src[0] >> shift) & (SORT_RADIX_SIZE - 1)] == count)
             continue;
-        }
 
-        for (uint32_t i = gap; i < count; i++ )
+        uint32_t sum = 0;
+        for (uint32_t d = 0; d < SORT_RADIX_SIZE; d++)
         {
-            uint32_t temp = array[i];
-            uint32_t j;
+            const uint32_t n = offset[d];
+            offset[d] = sum;
+            sum += n;
+        }
 
-            for (j = i; j >= gap && (compare(handle, array[j - gap], temp) == ord); j -= gap)
-            {
-                array[j] = array[j - gap];
-            }
+        for (uint32_t i = 0; i < count; i++)
+            dst[offset[(src[i] >> shift) & (SORT_RADIX_SIZE - 1)]++] = src[i];
 
-            array[j] = temp;
-        }
+        uint64_t* t = src;
+        src = dst;
+        dst = t;
+    }
+
+    return src;
+}
+
+//----------------------------------------------------------------------------
+
+static void sort_keys_sift_down(uint64_t* heap, uint32_t count, uint32_t root)
+{
+    const uint64_t key = heap[root];
+
+    for (uint32_t child = 2 * root + 1; child < count; child = 2 * root + 1)
+    {
+        if ((child + 1 < count) && (heap[child] < heap[child + 1]))
+            child++;
+        if (!(key < heap[child]))
+            break;
+        heap[root] = heap[child];
+        root = child;
     }
+
+    heap[root] = key;
 }
 
+//----------------------------------------------------------------------------
+
 static bool vector_alloc_size_overflow(size_t length, size_t elem_size, size_t data_offset, size_t* alloc_size)
 {
     if (ifx_util_overflow_mul_size_t(length, elem_size, alloc_size))
@@ -683,6 +1001,12 @@ void ifx_vec_complex_c(const ifx_Vector_R_t* input_real,
     IFX_VEC_BRK_DIM(input_real, output);
 
     const uint32_t len = vLen(input_real);
+    if (vStride(input_real) == 1 && vStride(input_imag) == 1 && vStride(output) == 1)
+    {
+        kernel_interleave(vDat(input_real), vDat(input_imag), (ifx_Float_t*)vDat(output), len);
+        return;
+    }
+
     for (uint32_t i = 0; i < len; i++)
     {
         IFX_COMPLEX_SET(vAt(output,i), vAt(input_real, i), vAt(input_imag, i));
@@ -691,6 +1015,33 @@ void ifx_vec_complex_c(const ifx_Vector_R_t* input_real,
 
 //----------------------------------------------------------------------------
 
+void ifx_vec_split_c(const ifx_Vector_C_t* input,
+                     ifx_Vector_R_t* output_real,
+                     ifx_Vector_R_t* output_imag)
+{
+    IFX_VEC_BRK_VALID(input);
+    IFX_VEC_BRK_VALID(output_real);
+    IFX_VEC_BRK_VALID(output_imag);
+
+    IFX_VEC_BRK_DIM(input, output_real);
+    IFX_VEC_BRK_DIM(input, output_imag);
+
+    const uint32_t len = vLen(input);
+    if (vStride(input) == 1 && vStride(output_real) == 1 && vStride(output_imag) == 1)
+    {
+        kernel_deinterleave((const ifx_Float_t*)vDat(input), vDat(output_real), vDat(output_imag), len);
+        return;
+    }
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        vAt(output_real, i) = IFX_COMPLEX_REAL(vAt(input, i));
+        vAt(output_imag, i) = IFX_COMPLEX_IMAG(vAt(input, i));
+    }
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_vec_set_range_r(ifx_Vector_R_t* vector,
                       uint32_t offset,
                       uint32_t length,
@@ -815,9 +1166,12 @@ ifx_Float_t ifx_vec_sqsum_c(const ifx_Vector_C_t* vector)
 {
     IFX_VEC_BRV_VALID(vector, 0);
 
-    ifx_Float_t result = 0.f;
     const uint32_t length = vLen(vector);
 
+    if (vStride(vector) == 1)
+        return kernel_csqsum((const ifx_Float_t*)vDat(vector), length);
+
+    ifx_Float_t result = 0.f;
     for (uint32_t i = 0; i < length; i++)
     {
         result = result + ifx_complex_sqnorm(vAt(vector, i));
@@ -969,6 +1323,12 @@ void ifx_vec_add_c(const ifx_Vector_C_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
+    if (vStride(v1) == 1 && vStride(v2) == 1 && vStride(result) == 1)
+    {
+        kernel_add((const ifx_Float_t*)vDat(v1), (const ifx_Float_t*)vDat(v2), (ifx_Float_t*)vDat(result), 2 * vLen(v1));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(v1); ++i)
     {
         vAt(result, i) = ifx_complex_add(vAt(v1, i), vAt(v2, i));
@@ -1005,6 +1365,12 @@ void ifx_vec_sub_c(const ifx_Vector_C_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
+    if (vStride(v1) == 1 && vStride(v2) == 1 && vStride(result) == 1)
+    {
+        kernel_sub((const ifx_Float_t*)vDat(v1), (const ifx_Float_t*)vDat(v2), (ifx_Float_t*)vDat(result), 2 * vLen(v1));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(v1); ++i)
     {
         vAt(result, i) = ifx_complex_sub(vAt(v1, i), vAt(v2, i));
@@ -1041,6 +1407,12 @@ void ifx_vec_mul_c(const ifx_Vector_C_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
+    if (vStride(v1) == 1 && vStride(v2) == 1 && vStride(result) == 1)
+    {
+        kernel_cmul((const ifx_Float_t*)vDat(v1), (const ifx_Float_t*)vDat(v2), (ifx_Float_t*)vDat(result), vLen(v1));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(v1); ++i)
     {
         vAt(result, i) = ifx_complex_mul(vAt(v1, i), vAt(v2, i));
@@ -1059,6 +1431,12 @@ void ifx_vec_mul_cr(const ifx_Vector_C_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
+    if (vStride(v1) == 1 && vStride(v2) == 1 && vStride(result) == 1)
+    {
+        kernel_cmul_real((const ifx_Float_t*)vDat(v1), vDat(v2), (ifx_Float_t*)vDat(result), vLen(v1));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(v1); ++i)
     {
         vAt(result, i) = ifx_complex_mul_real(vAt(v1, i), vAt(v2, i));
@@ -1085,6 +1463,12 @@ void ifx_vec_abs_c(const ifx_Vector_C_t* input,
 {
     IFX_VEC_BRK_DIM(input, output);
 
+    if (vStride(input) == 1 && vStride(output) == 1)
+    {
+        kernel_cabs((const ifx_Float_t*)vDat(input), vDat(output), vLen(input));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(input); ++i)
     {
         vAt(output, i) = ifx_complex_abs(vAt(input, i));
@@ -1093,6 +1477,27 @@ void ifx_vec_abs_c(const ifx_Vector_C_t* input,
 
 //----------------------------------------------------------------------------
 
+void ifx_vec_sqnorm_db_c(const ifx_Vector_C_t* input,
+                         ifx_Vector_R_t* output)
+{
+    IFX_VEC_BRK_VALID(input);
+    IFX_VEC_BRK_VALID(output);
+    IFX_VEC_BRK_DIM(input, output);
+
+    if (vStride(input) == 1 && vStride(output) == 1)
+    {
+        kernel_csqnorm_db((const ifx_Float_t*)vDat(input), vDat(output), vLen(input));
+        return;
+    }
+
+    for (uint32_t i = 0; i < vLen(input); ++i)
+    {
+        vAt(output, i) = DB_PER_LOG2 * ifx_simd_log2(ifx_complex_sqnorm(vAt(input, i)));
+    }
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_vec_flip_r(const ifx_Vector_R_t* input,
     ifx_Vector_R_t* output)
 {
@@ -1178,6 +1583,12 @@ void ifx_vec_scale_c(const ifx_Vector_C_t* input,
     IFX_VEC_BRK_VALID(output);
     IFX_VEC_BRK_DIM(input, output);
 
+    if (vStride(input) == 1 && vStride(output) == 1)
+    {
+        kernel_cscale((const ifx_Float_t*)vDat(input), scale, (ifx_Float_t*)vDat(output), vLen(input));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(input); ++i)
     {
         vAt(output, i) = ifx_complex_mul(vAt(input, i), scale);
@@ -1194,6 +1605,12 @@ void ifx_vec_scale_cr(const ifx_Vector_C_t* input,
     IFX_VEC_BRK_VALID(output);
     IFX_VEC_BRK_DIM(input, output);
 
+    if (vStride(input) == 1 && vStride(output) == 1)
+    {
+        kernel_scale((const ifx_Float_t*)vDat(input), scale, (ifx_Float_t*)vDat(output), 2 * vLen(input));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(input); ++i)
     {
         vAt(output, i) = ifx_complex_mul_real(vAt(input, i), scale);
@@ -1229,8 +1646,102 @@ void ifx_vec_isort_r(const ifx_Vector_R_t* input,
                      uint32_t* sorted_idxs)
 {
     IFX_VEC_BRK_VALID(input);
+    IFX_ERR_BRK_NULL(sorted_idxs);
+
+    const uint32_t count = vLen(input);
+
+    if (count <= SORT_SMALL)
+    {
+        uint64_t keys[SORT_SMALL];
+        for (uint32_t i = 0; i < count; i++)
+            keys[i] = sort_key(input, i, order);
+
+        sort_keys_insertion(keys, count);
+
+        for (uint32_t i = 0; i < count; i++)
+            sorted_idxs[i] = (uint32_t)keys[i];
+        return;
+    }
+
+    uint64_t* keys = ifx_mem_alloc(2 * (size_t)count * sizeof(uint64_t));
+    IFX_ERR_BRK_MEMALLOC(keys);
+
+    for (uint32_t i = 0; i < count; i++)
+        keys[i] = sort_key(input, i, order);
+
+    const uint64_t* sorted = sort_keys_radix(keys, keys + count, count);
+
+    for (uint32_t i = 0; i < count; i++)
+        sorted_idxs[i] = (uint32_t)sorted[i];
+
+    ifx_mem_free(keys);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_vec_isort_topk_r(const ifx_Vector_R_t* input,
+                          ifx_Vector_Sort_Order_t order,
+                          uint32_t k,
+                          uint32_t* sorted_idxs)
+{
+    IFX_VEC_BRK_VALID(input);
+    IFX_ERR_BRK_NULL(sorted_idxs);
+    IFX_ERR_BRK_ARGUMENT(k > vLen(input));
+
+    const uint32_t count = vLen(input);
+    if (k == 0)
+        return;
+
+    // for large k sorting everything is cheaper than the heap
+    if ((k > SORT_TOPK_STACK_SIZE) && (k > count / 8))
+    {
+        uint32_t* all = (k == count) ? sorted_idxs : ifx_mem_alloc(count * sizeof(uint32_t));
+        IFX_ERR_BRK_MEMALLOC(all);
+
+        ifx_vec_isort_r(input, order, all);
+
+        if (all != sorted_idxs)
+        {
+            memcpy(sorted_idxs, all, k * sizeof(uint32_t));
+            ifx_mem_free(all);
+        }
+        return;
+    }
+
+    uint64_t buffer[SORT_TOPK_STACK_SIZE];
+    uint64_t* heap = (k <= SORT_TOPK_STACK_SIZE) ? buffer : ifx_mem_alloc(k * sizeof(uint64_t));
+    IFX_ERR_BRK_MEMALLOC(heap);
+
+    // max heap of the k first keys seen so far, its root is replaced by
+    // every smaller key
+    for (uint32_t i = 0; i < k; i++)
+        heap[i] = sort_key(input, i, order);
+    for (uint32_t i = k / 2; i-- > 0;)
+        sort_keys_sift_down(heap, k, i);
 
-    ssort(vDat(input), vLen(input), float_compare, order, sorted_idxs);
+    for (uint32_t i = k; i < count; i++)
+    {
+        const uint64_t key = sort_key(input, i, order);
+        if (key < heap[0])
+        {
+            heap[0] = key;
+            sort_keys_sift_down(heap, k, 0);
+        }
+    }
+
+    for (uint32_t end = k; end-- > 1;)
+    {
+        const uint64_t t = heap[0];
+        heap[0] = heap[end];
+        heap[end] = t;
+        sort_keys_sift_down(heap, end, 0);
+    }
+
+    for (uint32_t i = 0; i < k; i++)
+        sorted_idxs[i] = (uint32_t)heap[i];
+
+    if (heap != buffer)
+        ifx_mem_free(heap);
 }
 
 //----------------------------------------------------------------------------
@@ -1265,6 +1776,12 @@ void ifx_vec_mac_c(const ifx_Vector_C_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
+    if (vStride(v1) == 1 && vStride(v2) == 1 && vStride(result) == 1)
+    {
+        kernel_cmac((const ifx_Float_t*)vDat(v1), (const ifx_Float_t*)vDat(v2), scale, (ifx_Float_t*)vDat(result), vLen(v1));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(v1); ++i)
     {
         vAt(result, i) = ifx_complex_add(vAt(v1, i), ifx_complex_mul(vAt(v2, i), scale));
@@ -1428,76 +1945,157 @@ void ifx_vec_linspace_r(const ifx_Float_t start,
 
 //----------------------------------------------------------------------------
 
-static int median_rank(
-        const ifx_Vector_R_t* input, uint32_t offset, 
-        uint32_t number_of_el, uint32_t pick_pos_offsetted)
+static void heapsort_range(ifx_Float_t* values, uint32_t count)
 {
-    int res = 0;
-    ifx_Float_t val = vAt(input, pick_pos_offsetted+offset);
-    for(uint32_t i = 0; i < pick_pos_offsetted; i++)
+    // build a max heap, then move the maximum to the end repeatedly
+    for (uint32_t start = count / 2; start-- > 0;)
     {
-        if(val >= vAt(input,i+offset)) //There is difference if you are before or after index (==)
-        { 
-            res++;
-        } else {
-            res--;
+        for (uint32_t root = start; 2 * root + 1 < count;)
+        {
+            uint32_t child = 2 * root + 1;
+            if ((child + 1 < count) && (values[child] < values[child + 1]))
+                child++;
+            if (!(values[root] < values[child]))
+                break;
+            const ifx_Float_t t = values[root];
+            values[root] = values[child];
+            values[child] = t;
+            root = child;
         }
     }
-    for(uint32_t i = pick_pos_offsetted + 1; i < number_of_el; i++)
+
+    for (uint32_t end = count; end-- > 1;)
     {
-        if(val > vAt(input,i+offset)) //There is difference if you are before or after index (==)
-        {   
-            res++;
-        } else {
-            res--;
+        ifx_Float_t t = values[0];
+        values[0] = values[end];
+        values[end] = t;
+
+        for (uint32_t root = 0; 2 * root + 1 < end;)
+        {
+            uint32_t child = 2 * root + 1;
+            if ((child + 1 < end) && (values[child] < values[child + 1]))
+                child++;
+            if (!(values[root] < values[child]))
+                break;
+            t = values[root];
+            values[root] = values[child];
+            values[child] = t;
+            root = child;
         }
     }
-    return res;
 }
 
 //----------------------------------------------------------------------------
 
-ifx_Float_t ifx_vect_median_range_r(const ifx_Vector_R_t* input, uint32_t offset, uint32_t length)
+static void select_nth(ifx_Float_t* values, uint32_t count, uint32_t k)
 {
-    IFX_ERR_BRV_NULL(input, IFX_NAN);
-    IFX_ERR_BRV_ARGUMENT(vLen(input) < length + offset, IFX_NAN); 
-    
-    ifx_Float_t upper_limit = IFX_INF_POS;
-    ifx_Float_t lower_limit = IFX_INF_NEG;
-    
-    const int32_t undef_idx = -1;   
-    int32_t prev_idx = undef_idx;
-    
-    for(int32_t idx = 0; idx < (int32_t)length; idx++)
-    {
-        ifx_Float_t val = vAt(input, idx + offset);
-        if(val>upper_limit || val<lower_limit)
+    uint32_t lo = 0;
+    uint32_t hi = count;
+    uint32_t budget = 0;
+
+    for (uint32_t n = count; n > 1; n /= 2)
+        budget += 2;
+
+    while (hi - lo > SELECT_SMALL)
+    {
+        if (budget-- == 0)
         {
-            continue;
+            heapsort_range(values + lo, hi - lo);
+            return;
         }
-        int rank = median_rank(input, offset, length, idx);
-        if(rank == 0)
+
+        // order first, middle and last value, the middle one is the pivot
+        // and the outer ones stop the scans below
+        const uint32_t mid = lo + (hi - lo) / 2;
+        ifx_Float_t t;
+        if (values[mid] < values[lo]) { t = values[mid]; values[mid] = values[lo]; values[lo] = t; }
+        if (values[hi - 1] < values[mid])
         {
-            return val;
-        } 
-        else if(rank == 1 || rank == -1) //Only happens for length n%2==0
+            t = values[mid]; values[mid] = values[hi - 1]; values[hi - 1] = t;
+            if (values[mid] < values[lo]) { t = values[mid]; values[mid] = values[lo]; values[lo] = t; }
+        }
+        const ifx_Float_t pivot = values[mid];
+
+        // Hoare partition: afterwards [lo, j] <= pivot <= [j + 1, hi)
+        uint32_t i = lo - 1;
+        uint32_t j = hi;
+        for (;;)
         {
-            if(prev_idx != undef_idx)
-            {
-                ifx_Float_t val_prev = vAt(input, prev_idx + offset);        
-                return (val+val_prev)/2;
-            }
-            prev_idx = idx;
+            do { i++; } while (values[i] < pivot);
+            do { j--; } while (pivot < values[j]);
+            if (i >= j)
+                break;
+            t = values[i];
+            values[i] = values[j];
+            values[j] = t;
         }
 
-        if(rank >= 0)
+        if (k <= j)
+            hi = j + 1;
+        else
+            lo = j + 1;
+    }
+
+    for (uint32_t i = lo + 1; i < hi; i++)
+    {
+        const ifx_Float_t v = values[i];
+        uint32_t j = i;
+        for (; (j > lo) && (v < values[j - 1]); j--)
+            values[j] = values[j - 1];
+        values[j] = v;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static ifx_Float_t* copy_range(const ifx_Vector_R_t* input, uint32_t offset, uint32_t length,
+                               ifx_Float_t* buffer)
+{
+    ifx_Float_t* values = (length <= SELECT_STACK_SIZE) ? buffer : ifx_mem_alloc(length * sizeof(ifx_Float_t));
+    IFX_ERR_BRN_MEMALLOC(values);
+
+    for (uint32_t i = 0; i < length; i++)
+        values[i] = vAt(input, offset + i);
+
+    return values;
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Float_t ifx_vect_median_range_r(const ifx_Vector_R_t* input, uint32_t offset, uint32_t length)
+{
+    IFX_ERR_BRV_NULL(input, IFX_NAN);
+    IFX_ERR_BRV_ARGUMENT(vLen(input) < length + offset, IFX_NAN);
+
+    if (length == 0)
+        return IFX_NAN;
+
+    ifx_Float_t buffer[SELECT_STACK_SIZE];
+    ifx_Float_t* values = copy_range(input, offset, length, buffer);
+    if (values == NULL)
+        return IFX_NAN;
+
+    // upper middle value, for even lengths the lower one is the largest
+    // value before it
+    const uint32_t k = length / 2;
+    select_nth(values, length, k);
+
+    ifx_Float_t median = values[k];
+    if ((length & 1) == 0)
+    {
+        ifx_Float_t lower = values[0];
+        for (uint32_t i = 1; i < k; i++)
         {
-            upper_limit = val;
-        } else {
-            lower_limit = val;
+            if (values[i] > lower)
+                lower = values[i];
         }
+        median = (median + lower) / 2;
     }
-    return IFX_NAN;
+
+    if (values != buffer)
+        ifx_mem_free(values);
+
+    return median;
 }
 
 //----------------------------------------------------------------------------
@@ -1508,6 +2106,49 @@ ifx_Float_t ifx_vect_median_r(const ifx_Vector_R_t* input){
 
 //----------------------------------------------------------------------------
 
+ifx_Float_t ifx_vec_percentile_r(const ifx_Vector_R_t* input, ifx_Float_t percentile)
+{
+    IFX_VEC_BRV_VALID(input, IFX_NAN);
+    IFX_ERR_BRV_ARGUMENT(!((percentile >= 0) && (percentile <= 100)), IFX_NAN);
+
+    const uint32_t length = vLen(input);
+    if (length == 0)
+        return IFX_NAN;
+
+    ifx_Float_t buffer[SELECT_STACK_SIZE];
+    ifx_Float_t* values = copy_range(input, 0, length, buffer);
+    if (values == NULL)
+        return IFX_NAN;
+
+    // linear interpolation between the values of the closest ranks
+    const double position = (double)percentile / 100 * (length - 1);
+    uint32_t k = (uint32_t)position;
+    if (k > length - 1)
+        k = length - 1;
+    const ifx_Float_t fraction = (ifx_Float_t)(position - k);
+
+    select_nth(values, length, k);
+
+    ifx_Float_t result = values[k];
+    if ((fraction > 0) && (k + 1 < length))
+    {
+        ifx_Float_t next = values[k + 1];
+        for (uint32_t i = k + 2; i < length; i++)
+        {
+            if (values[i] < next)
+                next = values[i];
+        }
+        result += fraction * (next - result);
+    }
+
+    if (values != buffer)
+        ifx_mem_free(values);
+
+    return result;
+}
+
+//----------------------------------------------------------------------------
+
 bool ifx_vec_is_zero_r(ifx_Vector_R_t* vector)
 {
     IFX_ERR_BRV_NULL(vector, false);
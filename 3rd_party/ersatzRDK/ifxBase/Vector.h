@@ -476,6 +476,22 @@ void ifx_vec_complex_c(const ifx_Vector_R_t* input_real,
     const ifx_Vector_R_t* input_imag,
     ifx_Vector_C_t* output);
 
+/**
+ * @brief Splits a complex vector into its real and imaginary parts.
+ *
+ * Inverse of \ref ifx_vec_complex_c. Kernels working on separate real and
+ * imaginary arrays can use this to convert interleaved data once.
+ *
+ * @param [in]     input        Pointer to data memory defined by \ref ifx_Vector_C_t
+ * @param [out]    output_real  Real parts, same length as input
+ * @param [out]    output_imag  Imaginary parts, same length as input
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_vec_split_c(const ifx_Vector_C_t* input,
+                     ifx_Vector_R_t* output_real,
+                     ifx_Vector_R_t* output_imag);
+
 /**
  * @brief Set all values in given range to same given value
  *
@@ -761,6 +777,22 @@ IFX_DLL_PUBLIC
 void ifx_vec_abs_c(const ifx_Vector_C_t* input,
                    ifx_Vector_R_t* output);
 
+/**
+ * @brief Computes the power in dB of complex input data. Output = 10*log10(real^2 + imag^2)
+ *
+ * Fused replacement for \ref ifx_vec_abs_c followed by a conversion to dB,
+ * without square root or log10 per element. The logarithm is a polynomial
+ * approximation with an error below 1e-4 dB. Zero and values whose
+ * squared magnitude is below FLT_MIN give -inf.
+ *
+ * @param [in]     input     Pointer to data memory defined by \ref ifx_Vector_C_t
+ * @param [out]    output    Pointer to data memory defined by \ref ifx_Vector_R_t
+ *                           containing the power in dB.
+ */
+IFX_DLL_PUBLIC
+void ifx_vec_sqnorm_db_c(const ifx_Vector_C_t* input,
+                         ifx_Vector_R_t* output);
+
 /**
  * @brief flips real vector.
  * populates vector 'output' with a reverse of the order of the elements in vector 'input'
@@ -880,6 +912,14 @@ ifx_Float_t ifx_vec_distance_r(const ifx_Vector_R_t* v1,
 /**
  * @brief Sorts real vector indices.
  *
+ * The sort is stable, indices of equal values stay in ascending order for
+ * both sorting orders. Values are compared by their float bits, so -0 is
+ * sorted before +0 and NaNs end up beyond the infinities of their sign.
+ *
+ * Vectors of up to 64 elements are sorted by insertion sort, longer ones by
+ * a radix sort on the float bits which takes linear time but allocates
+ * 16 bytes per element temporarily.
+ *
  * @param [in]     input               Pointer to data memory defined by \ref ifx_Vector_R_t.
  * @param [in]     order               Sorting order defined by \ref ifx_Vector_Sort_Order_t.
  * @param [out]    sorted_idxs         Pointer to sorted indices array.
@@ -890,6 +930,26 @@ void ifx_vec_isort_r(const ifx_Vector_R_t* input,
                      ifx_Vector_Sort_Order_t order,
                      uint32_t* sorted_idxs);
 
+/**
+ * @brief Sorts the indices of the k first values in the given order, e.g.
+ *        the k strongest targets.
+ *
+ * The result equals the first k indices of \ref ifx_vec_isort_r. Small k
+ * are selected with a heap in O(n log k) time, for k above 256 and an
+ * eighth of the vector length the whole vector is sorted.
+ *
+ * @param [in]     input               Pointer to data memory defined by \ref ifx_Vector_R_t.
+ * @param [in]     order               Sorting order defined by \ref ifx_Vector_Sort_Order_t.
+ * @param [in]     k                   Number of indices, not more than the vector length.
+ * @param [out]    sorted_idxs         Array of k sorted indices.
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_vec_isort_topk_r(const ifx_Vector_R_t* input,
+                          ifx_Vector_Sort_Order_t order,
+                          uint32_t k,
+                          uint32_t* sorted_idxs);
+
 /**
  * @brief Applies multiply accumulate (MAC) operation on real vectors.
  *
@@ -1040,12 +1100,10 @@ void ifx_vec_linspace_r(const ifx_Float_t start,
  * Median is defined as value lying in midpoint of values that where previously sorted. 
  * If the midpoint is betwean of two values the mean of them is taken as result.
  * 
- * This algorithm is complexity is nlog(n) efficient for smaller tables rather 
- * hundreds not thousends, it is also not efficient by that could cause worst cases n^2 complexity. 
- * Algorithm was not randomise to avoid cornel of specifically sorted data not to add additional 
- * overhead for usage in filters.
- * 
- * Used algorithm is doing finding of median in place without creating any additional arrays.
+ * The median is selected with introselect from a copy of the range, which
+ * takes linear time on average and O(n log n) in the worst case. Ranges of
+ * up to 256 values are copied to the stack, longer ones to allocated memory.
+ * For medians over a window sliding along the data use \ref gr_median_filter.
  * 
  * @param [in]     input     input data
  * @param [in]     offset    start position where fining median
@@ -1068,6 +1126,21 @@ ifx_Float_t ifx_vect_median_range_r(const ifx_Vector_R_t* input, uint32_t offset
 IFX_DLL_PUBLIC
 ifx_Float_t ifx_vect_median_r(const ifx_Vector_R_t* input);
 
+/**
+ * @brief Computes a percentile
+ *
+ * The result is interpolated linearly between the values of the two closest
+ * ranks, so percentile 0 is the minimum, 50 the median and 100 the maximum.
+ * The value is selected like in \ref ifx_vect_median_range_r.
+ *
+ * @param [in]     input      input data
+ * @param [in]     percentile percentile from 0 to 100
+ * @retval         NaN        if 0 elements on input or error
+ * @retval         percentile otherwise
+ */
+IFX_DLL_PUBLIC
+ifx_Float_t ifx_vec_percentile_r(const ifx_Vector_R_t* input, ifx_Float_t percentile);
+
 /**
 * @brief Checks if given vector is a zero vector (null vector) with only zeros.
 *
@@ -0,0 +1,268 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Window.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Mem.h"
+#include "ifxBase/internal/Macros.h"
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+#define WINDOW_PI 3.14159265358979323846
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+namespace {
+
+struct VectorDeleter
+{
+    void operator()(ifx_Vector_R_t* vector) const { ifx_vec_destroy_r(vector); }
+};
+
+// window type, size, attenuation and scale, the floats compared bitwise
+typedef std::tuple<int, uint32_t, uint32_t, uint32_t> WindowKey;
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+std::mutex cache_mutex;
+std::map<WindowKey, std::unique_ptr<ifx_Vector_R_t, VectorDeleter>> cache;
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+uint32_t float_bits(ifx_Float_t value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+//----------------------------------------------------------------------------
+
+bool config_valid(const ifx_Window_Config_t* config)
+{
+    switch (config->type)
+    {
+    case IFX_WINDOW_HAMM:
+    case IFX_WINDOW_HANN:
+    case IFX_WINDOW_BLACKMANHARRIS:
+        return config->size > 0;
+    case IFX_WINDOW_CHEBYSHEV:
+        return (config->size > 0) && (config->at_dB > 0);
+    default:
+        return false;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/* Chebyshev polynomial of degree m, also outside of [-1, 1] */
+double chebyshev_poly(uint32_t m, double x)
+{
+    if (x > 1)
+        return cosh(m * acosh(x));
+    if (x < -1)
+        return ((m & 1) ? -1 : 1) * cosh(m * acosh(-x));
+    return cos(m * acos(x));
+}
+
+//----------------------------------------------------------------------------
+
+/* Dolph-Chebyshev window as inverse DFT of the equiripple spectrum
+ * T_(N-1)(x0 * cos(pi * k / N)), centered on the window. The spectrum is
+ * real and symmetric, so the transform reduces to a cosine sum. */
+bool chebyshev_window(uint32_t size, double at_dB, ifx_Float_t* coeffs)
+{
+    const uint32_t order = size - 1;
+    const double x0 = cosh(acosh(pow(10.0, at_dB / 20)) / order);
+
+    double* w = static_cast<double*>(ifx_mem_alloc(size * sizeof(double)));
+    IFX_ERR_BRV_MEMALLOC(w, false);
+
+    double max = 0;
+
+    for (uint32_t n = 0; n <= order / 2; n++)
+    {
+        double sum = 0;
+        for (uint32_t k = 0; k < size; k++)
+        {
+            const double p = chebyshev_poly(order, x0 * cos(WINDOW_PI * k / size));
+            sum += p * cos(2 * WINDOW_PI * k * (n - order / 2.0) / size);
+        }
+        w[n] = w[order - n] = sum;
+        if (fabs(sum) > max)
+            max = fabs(sum);
+    }
+
+    for (uint32_t n = 0; n < size; n++)
+        coeffs[n] = (ifx_Float_t)(w[n] / max);
+
+    ifx_mem_free(w);
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+bool compute_window(const ifx_Window_Config_t* config, ifx_Float_t* coeffs)
+{
+    const uint32_t size = config->size;
+    const double scale = (config->scale != 0) ? config->scale : 1;
+
+    if (size == 1)
+    {
+        coeffs[0] = (ifx_Float_t)scale;
+        return true;
+    }
+
+    if (config->type == IFX_WINDOW_CHEBYSHEV)
+    {
+        if (!chebyshev_window(size, config->at_dB, coeffs))
+            return false;
+        for (uint32_t n = 0; n < size; n++)
+            coeffs[n] = (ifx_Float_t)(coeffs[n] * scale);
+        return true;
+    }
+
+    // cosine sums a0 - a1 cos(x) + a2 cos(2x) - a3 cos(3x)
+    double a[4] = { 0, 0, 0, 0 };
+    switch (config->type)
+    {
+    case IFX_WINDOW_HAMM:
+        a[0] = 0.54;
+        a[1] = 0.46;
+        break;
+    case IFX_WINDOW_HANN:
+        a[0] = 0.5;
+        a[1] = 0.5;
+        break;
+    default:
+        a[0] = 0.35875;
+        a[1] = 0.48829;
+        a[2] = 0.14128;
+        a[3] = 0.01168;
+        break;
+    }
+
+    for (uint32_t n = 0; n < size; n++)
+    {
+        const double x = 2 * WINDOW_PI * n / (size - 1);
+        const double w = a[0] - a[1] * cos(x) + a[2] * cos(2 * x) - a[3] * cos(3 * x);
+        coeffs[n] = (ifx_Float_t)(w * scale);
+    }
+
+    return true;
+}
+
+} // namespace
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+void ifx_window_init(const ifx_Window_Config_t* config,
+                     ifx_Vector_R_t* window)
+{
+    IFX_ERR_BRK_NULL(config);
+    IFX_VEC_BRK_VALID(window);
+    IFX_ERR_BRK_ARGUMENT(!config_valid(config));
+    IFX_ERR_BRK_COND(vLen(window) != config->size, IFX_ERROR_DIMENSION_MISMATCH);
+
+    if (vStride(window) == 1)
+    {
+        compute_window(config, vDat(window));
+        return;
+    }
+
+    ifx_Vector_R_t* tmp = ifx_vec_create_r(config->size);
+    IFX_ERR_BRK_MEMALLOC(tmp);
+
+    if (compute_window(config, vDat(tmp)))
+        ifx_vec_copy_r(tmp, window);
+    ifx_vec_destroy_r(tmp);
+}
+
+//----------------------------------------------------------------------------
+
+const ifx_Vector_R_t* ifx_window_get(const ifx_Window_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_ARGUMENT(!config_valid(config));
+
+    const ifx_Float_t at_dB = (config->type == IFX_WINDOW_CHEBYSHEV) ? config->at_dB : 0;
+    const ifx_Float_t scale = (config->scale != 0) ? config->scale : 1;
+    const WindowKey key((int)config->type, config->size, float_bits(at_dB), float_bits(scale));
+
+    std::lock_guard<std::mutex> guard(cache_mutex);
+
+    auto it = cache.find(key);
+    if (it != cache.end())
+        return it->second.get();
+
+    ifx_Vector_R_t* window = ifx_vec_create_r(config->size);
+    IFX_ERR_BRN_MEMALLOC(window);
+
+    if (!compute_window(config, vDat(window)))
+    {
+        ifx_vec_destroy_r(window);
+        return NULL;
+    }
+    cache[key].reset(window);
+
+    return window;
+}
@@ -0,0 +1,159 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file Window.h
+ *
+ * \brief \copybrief gr_window
+ *
+ * For details refer to \ref gr_window
+ */
+
+#ifndef IFX_BASE_WINDOW_H
+#define IFX_BASE_WINDOW_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Defines.h"
+#include "ifxBase/Types.h"
+#include "ifxBase/Vector.h"
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Defines supported window functions.
+ */
+typedef enum
+{
+    IFX_WINDOW_HAMM           = 0U, /**< Hamming window */
+    IFX_WINDOW_HANN           = 1U, /**< Hann window */
+    IFX_WINDOW_BLACKMANHARRIS = 2U, /**< 4-term Blackman-Harris window */
+    IFX_WINDOW_CHEBYSHEV      = 3U, /**< Dolph-Chebyshev window with at_dB side lobe attenuation */
+} ifx_Window_Type_t;
+
+/**
+ * @brief Configuration of a window function.
+ */
+typedef struct
+{
+    ifx_Window_Type_t type;     /**< Window function */
+    uint32_t size;              /**< Number of coefficients */
+    ifx_Float_t at_dB;          /**< Side lobe attenuation in dB, only used by the Chebyshev window */
+    ifx_Float_t scale;          /**< Factor applied to all coefficients, 0 is treated as 1 */
+} ifx_Window_Config_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_SDK_base
+  * @{
+  */
+
+/** @defgroup gr_window Window
+  * @brief API for window functions
+  *
+  * Windows are symmetric. Hann, Hamming and Blackman-Harris follow the
+  * textbook definition a0 - a1 cos(2 pi n / (size - 1)) + ... without
+  * normalization, so their peak is 1 only for odd sizes (Hann with size 4
+  * is 0, 0.75, 0.75, 0). Chebyshev windows are normalized to a peak of 1.
+  * The scale is applied afterwards.
+  *
+  * Computing a window costs a few transcendental functions per coefficient,
+  * for Chebyshev windows O(size^2). \ref ifx_window_get computes each
+  * configuration once and hands out the same read-only table afterwards, so
+  * the coefficients can be fetched whenever a processing stage is set up.
+  * Instead of multiplying the data with the window in a separate pass the
+  * table is best folded into a pass which touches the data anyway, e.g. the
+  * conversion of the ADC values (direct_device_configure_window()) or the
+  * input of an FFT (\ref ifx_fft_set_window).
+  *
+  * @{
+  */
+
+/**
+ * @brief Computes the coefficients of a window function.
+ *
+ * @param [in]     config    Window configuration.
+ * @param [out]    window    Vector receiving the coefficients, its length
+ *                           must be config->size.
+ */
+IFX_DLL_PUBLIC
+void ifx_window_init(const ifx_Window_Config_t* config,
+                     ifx_Vector_R_t* window);
+
+/**
+ * @brief Returns the coefficients of a window function from the window cache.
+ *
+ * The table is computed on the first request for a configuration. The
+ * returned vector is shared by all users of the configuration, it must not
+ * be modified or destroyed and stays valid until the program exits. The
+ * function is thread safe.
+ *
+ * @param [in]     config    Window configuration.
+ *
+ * @return Window coefficients, NULL in case of an error.
+ */
+IFX_DLL_PUBLIC
+const ifx_Vector_R_t* ifx_window_get(const ifx_Window_Config_t* config);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif /* IFX_BASE_WINDOW_H */
@@ -0,0 +1,290 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#ifndef IFX_BASE_SIMD_INTERNAL_H
+#define IFX_BASE_SIMD_INTERNAL_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+#define IFX_SIMD_SSE
+#include <xmmintrin.h>
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define IFX_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define IFX_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/* v4_load and v4_store need addresses aligned to this many bytes, the
+ * unaligned variants any float address */
+#define IFX_SIMD_ALIGNMENT 16
+
+/* log2(x) = e + log2(m) with x = m * 2^e and m in [sqrt(1/2), sqrt(2)),
+ * log(m) = 2 atanh(t) with t = (m - 1) / (m + 1) and |t| < 0.172, so the
+ * series up to t^7 is exact to float precision */
+#define IFX_SIMD_LOG2_SQRT_HALF_BITS 0x3F3504F3
+#define IFX_SIMD_LOG2_C3 (1.0f / 3)
+#define IFX_SIMD_LOG2_C5 (1.0f / 5)
+#define IFX_SIMD_LOG2_C7 (1.0f / 7)
+#define IFX_SIMD_LOG2_SCALE 2.88539008f  /* 2 / ln(2) */
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/* Fast log2 of a float, -inf for zero, values below FLT_MIN and NaN, +inf
+ * for +inf. Same algorithm as v4_log2, for tails of SIMD loops. */
+static inline float ifx_simd_log2(float x)
+{
+    if (!(x >= FLT_MIN))
+        return -INFINITY;
+    if (x > FLT_MAX)
+        return INFINITY;
+
+    int32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+
+    const int32_t d = bits - IFX_SIMD_LOG2_SQRT_HALF_BITS;
+    const int32_t e = (int32_t)((uint32_t)(d + 0x3F800000) >> 23) - 127;
+    const int32_t m_bits = (d & 0x007FFFFF) + IFX_SIMD_LOG2_SQRT_HALF_BITS;
+
+    float m;
+    memcpy(&m, &m_bits, sizeof(m));
+
+    const float t = (m - 1) / (m + 1);
+    const float t2 = t * t;
+    const float p = 1 + t2 * (IFX_SIMD_LOG2_C3 + t2 * (IFX_SIMD_LOG2_C5 + t2 * IFX_SIMD_LOG2_C7));
+
+    return (float)e + IFX_SIMD_LOG2_SCALE * t * p;
+}
+
+/* Vector of 4 floats with SSE, NEON or plain C. Only for use inside
+ * translation units of ifxBase, the functions are all static inline. */
+
+#if defined(IFX_SIMD_SSE)
+
+typedef __m128 v4_t;
+
+static inline v4_t v4_load(const float* p) { return _mm_load_ps(p); }
+static inline v4_t v4_loadu(const float* p) { return _mm_loadu_ps(p); }
+static inline void v4_store(float* p, v4_t a) { _mm_store_ps(p, a); }
+static inline void v4_storeu(float* p, v4_t a) { _mm_storeu_ps(p, a); }
+static inline v4_t v4_set1(float x) { return _mm_set1_ps(x); }
+static inline v4_t v4_add(v4_t a, v4_t b) { return _mm_add_ps(a, b); }
+static inline v4_t v4_sub(v4_t a, v4_t b) { return _mm_sub_ps(a, b); }
+static inline v4_t v4_mul(v4_t a, v4_t b) { return _mm_mul_ps(a, b); }
+static inline v4_t v4_madd(v4_t acc, v4_t a, v4_t b) { return _mm_add_ps(acc, _mm_mul_ps(a, b)); }
+
+static inline v4_t v4_div(v4_t a, v4_t b) { return _mm_div_ps(a, b); }
+static inline v4_t v4_sqrt(v4_t a) { return _mm_sqrt_ps(a); }
+
+static inline void v4_store_interleaved(float* p, v4_t re, v4_t im)
+{
+    _mm_storeu_ps(p, _mm_unpacklo_ps(re, im));
+    _mm_storeu_ps(p + 4, _mm_unpackhi_ps(re, im));
+}
+
+static inline void v4_load_deinterleaved(const float* p, v4_t* re, v4_t* im)
+{
+    const __m128 a = _mm_loadu_ps(p);
+    const __m128 b = _mm_loadu_ps(p + 4);
+    *re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    *im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+#if defined(IFX_SIMD_SSE2)
+
+static inline v4_t v4_log2(v4_t x)
+{
+    const __m128i d = _mm_sub_epi32(_mm_castps_si128(x), _mm_set1_epi32(IFX_SIMD_LOG2_SQRT_HALF_BITS));
+    const __m128i e = _mm_sub_epi32(_mm_srli_epi32(_mm_add_epi32(d, _mm_set1_epi32(0x3F800000)), 23), _mm_set1_epi32(127));
+    const __m128 m = _mm_castsi128_ps(_mm_add_epi32(_mm_and_si128(d, _mm_set1_epi32(0x007FFFFF)),
+                                                    _mm_set1_epi32(IFX_SIMD_LOG2_SQRT_HALF_BITS)));
+
+    const __m128 one = _mm_set1_ps(1);
+    const __m128 t = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+    const __m128 t2 = _mm_mul_ps(t, t);
+    __m128 p = _mm_add_ps(_mm_set1_ps(IFX_SIMD_LOG2_C5), _mm_mul_ps(t2, _mm_set1_ps(IFX_SIMD_LOG2_C7)));
+    p = _mm_add_ps(_mm_set1_ps(IFX_SIMD_LOG2_C3), _mm_mul_ps(t2, p));
+    p = _mm_add_ps(one, _mm_mul_ps(t2, p));
+
+    __m128 r = _mm_add_ps(_mm_cvtepi32_ps(e), _mm_mul_ps(_mm_set1_ps(IFX_SIMD_LOG2_SCALE), _mm_mul_ps(t, p)));
+
+    // +inf above FLT_MAX, then -inf below FLT_MIN and for NaN
+    const __m128 finite = _mm_cmple_ps(x, _mm_set1_ps(FLT_MAX));
+    r = _mm_or_ps(_mm_and_ps(finite, r), _mm_andnot_ps(finite, _mm_set1_ps(INFINITY)));
+    const __m128 normal = _mm_cmpge_ps(x, _mm_set1_ps(FLT_MIN));
+    return _mm_or_ps(_mm_and_ps(normal, r), _mm_andnot_ps(normal, _mm_set1_ps(-INFINITY)));
+}
+
+#else
+
+static inline v4_t v4_log2(v4_t x)
+{
+    float v[4];
+    _mm_storeu_ps(v, x);
+    for (int i = 0; i < 4; i++)
+        v[i] = ifx_simd_log2(v[i]);
+    return _mm_loadu_ps(v);
+}
+
+#endif
+
+#elif defined(IFX_SIMD_NEON)
+
+typedef float32x4_t v4_t;
+
+static inline v4_t v4_load(const float* p) { return vld1q_f32(p); }
+static inline v4_t v4_loadu(const float* p) { return vld1q_f32(p); }
+static inline void v4_store(float* p, v4_t a) { vst1q_f32(p, a); }
+static inline void v4_storeu(float* p, v4_t a) { vst1q_f32(p, a); }
+static inline v4_t v4_set1(float x) { return vdupq_n_f32(x); }
+static inline v4_t v4_add(v4_t a, v4_t b) { return vaddq_f32(a, b); }
+static inline v4_t v4_sub(v4_t a, v4_t b) { return vsubq_f32(a, b); }
+static inline v4_t v4_mul(v4_t a, v4_t b) { return vmulq_f32(a, b); }
+static inline v4_t v4_madd(v4_t acc, v4_t a, v4_t b) { return vmlaq_f32(acc, a, b); }
+
+static inline v4_t v4_div(v4_t a, v4_t b)
+{
+    // reciprocal estimate refined by two Newton-Raphson steps
+    float32x4_t r = vrecpeq_f32(b);
+    r = vmulq_f32(vrecpsq_f32(b, r), r);
+    r = vmulq_f32(vrecpsq_f32(b, r), r);
+    return vmulq_f32(a, r);
+}
+
+#if defined(__aarch64__)
+static inline v4_t v4_sqrt(v4_t a) { return vsqrtq_f32(a); }
+#else
+static inline v4_t v4_sqrt(v4_t a)
+{
+    float v[4];
+    vst1q_f32(v, a);
+    for (int i = 0; i < 4; i++)
+        v[i] = sqrtf(v[i]);
+    return vld1q_f32(v);
+}
+#endif
+
+static inline void v4_store_interleaved(float* p, v4_t re, v4_t im)
+{
+    float32x4x2_t v;
+    v.val[0] = re;
+    v.val[1] = im;
+    vst2q_f32(p, v);
+}
+
+static inline void v4_load_deinterleaved(const float* p, v4_t* re, v4_t* im)
+{
+    const float32x4x2_t v = vld2q_f32(p);
+    *re = v.val[0];
+    *im = v.val[1];
+}
+
+static inline v4_t v4_log2(v4_t x)
+{
+    const int32x4_t d = vsubq_s32(vreinterpretq_s32_f32(x), vdupq_n_s32(IFX_SIMD_LOG2_SQRT_HALF_BITS));
+    const uint32x4_t biased = vreinterpretq_u32_s32(vaddq_s32(d, vdupq_n_s32(0x3F800000)));
+    const int32x4_t e = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(biased, 23)), vdupq_n_s32(127));
+    const float32x4_t m = vreinterpretq_f32_s32(vaddq_s32(vandq_s32(d, vdupq_n_s32(0x007FFFFF)),
+                                                          vdupq_n_s32(IFX_SIMD_LOG2_SQRT_HALF_BITS)));
+
+    const float32x4_t one = vdupq_n_f32(1);
+    const float32x4_t t = v4_div(vsubq_f32(m, one), vaddq_f32(m, one));
+    const float32x4_t t2 = vmulq_f32(t, t);
+    float32x4_t p = vmlaq_f32(vdupq_n_f32(IFX_SIMD_LOG2_C5), t2, vdupq_n_f32(IFX_SIMD_LOG2_C7));
+    p = vmlaq_f32(vdupq_n_f32(IFX_SIMD_LOG2_C3), t2, p);
+    p = vmlaq_f32(one, t2, p);
+
+    float32x4_t r = vmlaq_f32(vcvtq_f32_s32(e), vdupq_n_f32(IFX_SIMD_LOG2_SCALE), vmulq_f32(t, p));
+
+    // +inf above FLT_MAX, then -inf below FLT_MIN and for NaN
+    r = vbslq_f32(vcleq_f32(x, vdupq_n_f32(FLT_MAX)), r, vdupq_n_f32(INFINITY));
+    return vbslq_f32(vcgeq_f32(x, vdupq_n_f32(FLT_MIN)), r, vdupq_n_f32(-INFINITY));
+}
+
+#else
+
+typedef struct { float v[4]; } v4_t;
+
+static inline v4_t v4_load(const float* p) { v4_t r; memcpy(r.v, p, sizeof(r.v)); return r; }
+static inline v4_t v4_loadu(const float* p) { return v4_load(p); }
+static inline void v4_store(float* p, v4_t a) { memcpy(p, a.v, sizeof(a.v)); }
+static inline void v4_storeu(float* p, v4_t a) { v4_store(p, a); }
+static inline v4_t v4_set1(float x) { v4_t r = { { x, x, x, x } }; return r; }
+static inline v4_t v4_add(v4_t a, v4_t b) { for(int i = 0; i < 4; i++) a.v[i] += b.v[i]; return a; }
+static inline v4_t v4_sub(v4_t a, v4_t b) { for(int i = 0; i < 4; i++) a.v[i] -= b.v[i]; return a; }
+static inline v4_t v4_mul(v4_t a, v4_t b) { for(int i = 0; i < 4; i++) a.v[i] *= b.v[i]; return a; }
+static inline v4_t v4_madd(v4_t acc, v4_t a, v4_t b) { for(int i = 0; i < 4; i++) acc.v[i] += a.v[i] * b.v[i]; return acc; }
+
+static inline v4_t v4_div(v4_t a, v4_t b) { for(int i = 0; i < 4; i++) a.v[i] /= b.v[i]; return a; }
+static inline v4_t v4_sqrt(v4_t a) { for(int i = 0; i < 4; i++) a.v[i] = sqrtf(a.v[i]); return a; }
+static inline v4_t v4_log2(v4_t a) { for(int i = 0; i < 4; i++) a.v[i] = ifx_simd_log2(a.v[i]); return a; }
+
+static inline void v4_store_interleaved(float* p, v4_t re, v4_t im)
+{
+    for(int i = 0; i < 4; i++)
+    {
+        p[2 * i] = re.v[i];
+        p[2 * i + 1] = im.v[i];
+    }
+}
+
+static inline void v4_load_deinterleaved(const float* p, v4_t* re, v4_t* im)
+{
+    for(int i = 0; i < 4; i++)
+    {
+        re->v[i] = p[2 * i];
+        im->v[i] = p[2 * i + 1];
+    }
+}
+
+#endif
+
+#endif /* IFX_BASE_SIMD_INTERNAL_H */
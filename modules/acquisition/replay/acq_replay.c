@@ -0,0 +1,570 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+/**
+ * @file acq_replay.c
+ *
+ * @brief Data source which replays binary recordings
+ *
+ * The recording is memory mapped and indexed when the acquisition starts,
+ * frames are then decoded into the output cubes on fetch. Rotated
+ * recordings are found by their index suffix, see record_format.h. The
+ * recorder starts a new part when the frame dimensions change, so every
+ * part keeps its own dimensions and the output cubes follow the part the
+ * frame comes from. Frames are delivered as fast as possible or, with
+ * replay.realtime, at the pace at which they were recorded.
+ */
+
+#include "interface/acquisition.h"
+#include "interface/record_format.h"
+#include "interface/report.h"
+#include "../../record/binary/rec_codec.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+static bool acq_set_file(const char *path);
+static bool acq_enable_realtime(bool enable);
+static bool acq_set_speed(int v);
+static bool acq_enable_loop(bool enable);
+
+static const app_option_t acq_options[] = {
+    APP_OPTION_PATH(
+        "file",
+        "binary recording to replay, as given to rec.file",
+        acq_set_file),
+    APP_OPTION_BOOL(
+        "realtime",
+        "deliver frames at the pace they were recorded instead of as fast as possible",
+        acq_enable_realtime),
+    APP_OPTION_INT(
+        "speed",
+        "replay speed in percent of the recorded pace, used with realtime",
+        acq_set_speed),
+    APP_OPTION_BOOL(
+        "loop",
+        "start over at the end of the recording",
+        acq_enable_loop),
+    APP_OPTION_END
+};
+
+const app_cmdarg_t acq_adesc = { "replay", "replay of binary recordings", acq_options };
+
+typedef struct {
+    uint8_t *map;
+    size_t size;
+    rec_codec_dims_t dims;
+} replay_file_t;
+
+typedef struct {
+    const uint8_t *data;
+    uint32_t size;
+    uint32_t file;
+    uint64_t timestamp_us;
+} replay_frame_t;
+
+static struct {
+    const char *path;
+    bool realtime;
+    uint32_t speed_percent;
+    bool loop;
+    uint32_t max_held_frames;
+
+    rec_file_header_t header;
+    size_t max_frame_count;
+    replay_file_t *files;
+    uint32_t num_files;
+    replay_frame_t *frames;
+    size_t num_frames;
+
+    // position in the recording and pacing reference
+    size_t next_frame;
+    uint64_t start_us;
+    uint64_t start_timestamp_us;
+
+    uint16_t *scratch;
+
+    // frames returned by acq_fetch_hold() stay valid until released
+    pthread_mutex_t lock;
+    ifx_Cube_R_t **cubes;
+    bool *held;
+    ifx_Cube_R_t *implicit;
+} s_replay = {
+    .speed_percent = 100,
+    .max_held_frames = 1,
+};
+
+void acq_init()
+{
+    pthread_mutex_init(&s_replay.lock, NULL);
+}
+
+void acq_deinit()
+{
+    acq_stop();
+    pthread_mutex_destroy(&s_replay.lock);
+}
+
+bool acq_set_file(const char *path)
+{
+    s_replay.path = path;
+    return true;
+}
+
+bool acq_enable_realtime(bool enable)
+{
+    s_replay.realtime = enable;
+    return true;
+}
+
+bool acq_set_speed(int v)
+{
+    if(v <= 0) {
+        rep_err("replay speed must be positive.\n");
+        return false;
+    }
+
+    s_replay.speed_percent = (uint32_t)v;
+    return true;
+}
+
+bool acq_enable_loop(bool enable)
+{
+    s_replay.loop = enable;
+    return true;
+}
+
+bool acq_set_max_held_frames(uint32_t num_frames)
+{
+    s_replay.max_held_frames = (num_frames > 0) ? num_frames : 1;
+    return true;
+}
+
+static uint64_t monotonic_us()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+/*
+==============================================================================
+   indexing
+==============================================================================
+*/
+
+/* Name of part index of a rotated recording, same scheme as the binary
+ * recorder uses. Returns false if the name doesn't fit into out. */
+static bool rotated_path(const char *path, uint32_t index, char *out, size_t size)
+{
+    const char *slash = strrchr(path, '/');
+    const char *dot = strrchr(path, '.');
+    if((dot == NULL) || ((slash != NULL) && (dot < slash)))
+        dot = path + strlen(path);
+
+    const int len = snprintf(out, size, "%.*s-%04u%s", (int)(dot - path), path, (unsigned)index, dot);
+    return (len >= 0) && ((size_t)len < size);
+}
+
+static bool map_file(const char *path, replay_file_t *file)
+{
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) {
+        rep_err("failed to open recording '%s'.\n", path);
+        return false;
+    }
+
+    struct stat st;
+    bool ok = (fstat(fd, &st) == 0) && (st.st_size >= (off_t)sizeof(rec_file_header_t));
+
+    if(ok) {
+        file->size = (size_t)st.st_size;
+        file->map = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ok = (file->map != MAP_FAILED);
+    }
+
+    if(ok)
+        madvise(file->map, file->size, MADV_SEQUENTIAL);
+    else
+        rep_err("failed to map recording '%s'.\n", path);
+
+    close(fd);
+    return ok;
+}
+
+static bool add_frame(const uint8_t *data, uint32_t size, uint32_t file, uint64_t timestamp_us)
+{
+    if((s_replay.num_frames & (s_replay.num_frames - 1)) == 0) {
+        const size_t capacity = s_replay.num_frames ? 2 * s_replay.num_frames : 1024;
+        replay_frame_t *frames = realloc(s_replay.frames, capacity * sizeof(replay_frame_t));
+        if(frames == NULL)
+            return false;
+        s_replay.frames = frames;
+    }
+
+    s_replay.frames[s_replay.num_frames++] = (replay_frame_t){ data, size, file, timestamp_us };
+    return true;
+}
+
+/* Checks the sample format against the first file, takes the dimensions
+ * of the file and adds all complete frames to the index. A file which
+ * wasn't closed properly may end in a partial frame or preallocated zeros,
+ * both end the file. */
+static bool index_file(const char *path, uint32_t index)
+{
+    replay_file_t *file = &s_replay.files[index];
+    rec_file_header_t header;
+    memcpy(&header, file->map, sizeof(header));
+
+    if((memcmp(header.magic, REC_FORMAT_MAGIC, 4) != 0) ||
+       (header.version != REC_FORMAT_VERSION) ||
+       (header.header_size < sizeof(header)) || (header.header_size > file->size)) {
+        rep_err("'%s' is not a binary recording.\n", path);
+        return false;
+    }
+
+    if(index == 0) {
+        s_replay.header = header;
+    }
+    else if(header.sample_format != s_replay.header.sample_format) {
+        rep_err("'%s' doesn't match the sample format of the first file of the recording.\n", path);
+        return false;
+    }
+
+    file->dims = (rec_codec_dims_t){ header.num_antennas,
+        header.num_chirps_per_frame, header.num_samples_per_chirp };
+
+    const size_t count = (size_t)header.num_antennas * header.num_chirps_per_frame *
+        header.num_samples_per_chirp;
+    const size_t float_size = count * sizeof(float);
+    if(count > s_replay.max_frame_count)
+        s_replay.max_frame_count = count;
+    size_t offset = header.header_size;
+
+    while(offset + sizeof(rec_frame_header_t) <= file->size) {
+        rec_frame_header_t frame;
+        memcpy(&frame, file->map + offset, sizeof(frame));
+        offset += sizeof(frame);
+
+        if((frame.frame_size == 0) || (frame.frame_size > file->size - offset))
+            break;
+
+        if((header.sample_format == REC_SAMPLE_FLOAT32) && (frame.frame_size != float_size)) {
+            rep_err("%s: frame %u has %u bytes, expected %zu.\n", path,
+                (unsigned)frame.frame_index, (unsigned)frame.frame_size, float_size);
+            return false;
+        }
+
+        if(!add_frame(file->map + offset, frame.frame_size, index, frame.timestamp_us))
+            return false;
+
+        offset += frame.frame_size;
+    }
+
+    return true;
+}
+
+static bool open_recording(const char *path)
+{
+    // same size as the recorder uses for the names of its files
+    char part[1100];
+    const int len = snprintf(part, sizeof(part), "%s", path);
+
+    // a rotated recording is given by the name passed to the recorder
+    const bool rotated = (access(path, F_OK) != 0);
+    if((len < 0) || ((size_t)len >= sizeof(part)) ||
+       (rotated && !rotated_path(path, 0, part, sizeof(part)))) {
+        rep_err("path of recording '%s' is too long.\n", path);
+        return false;
+    }
+
+    if(access(part, F_OK) != 0) {
+        rep_err("recording '%s' not found.\n", path);
+        return false;
+    }
+
+    for(uint32_t index = 0; (index == 0) || (rotated && (access(part, F_OK) == 0)); index++) {
+        replay_file_t *files = realloc(s_replay.files, (index + 1) * sizeof(replay_file_t));
+        if(files == NULL)
+            return false;
+        s_replay.files = files;
+
+        if(!map_file(part, &files[index]))
+            return false;
+        s_replay.num_files = index + 1;
+
+        if(!index_file(part, index))
+            return false;
+
+        if(rotated && !rotated_path(path, index + 1, part, sizeof(part))) {
+            rep_err("path of recording '%s' is too long.\n", path);
+            return false;
+        }
+    }
+
+    if((s_replay.header.sample_format != REC_SAMPLE_FLOAT32) &&
+       (s_replay.header.sample_format != REC_SAMPLE_CODED)) {
+        rep_err("sample format %u of '%s' is not supported.\n",
+            (unsigned)s_replay.header.sample_format, path);
+        return false;
+    }
+
+    if(s_replay.num_frames == 0) {
+        rep_err("recording '%s' doesn't contain any frames.\n", path);
+        return false;
+    }
+
+    rep_msg("replaying %zu frames from %u file(s) of '%s'.\n",
+        s_replay.num_frames, (unsigned)s_replay.num_files, path);
+    return true;
+}
+
+static void close_recording()
+{
+    for(uint32_t i = 0; i < s_replay.num_files; i++)
+        munmap(s_replay.files[i].map, s_replay.files[i].size);
+
+    free(s_replay.files);
+    free(s_replay.frames);
+    s_replay.files = NULL;
+    s_replay.num_files = 0;
+    s_replay.frames = NULL;
+    s_replay.num_frames = 0;
+    s_replay.max_frame_count = 0;
+}
+
+/*
+==============================================================================
+   acquisition interface
+==============================================================================
+*/
+
+bool acq_start()
+{
+    if(s_replay.path == NULL) {
+        rep_err("no recording to replay, set replay.file.\n");
+        return false;
+    }
+
+    if(!open_recording(s_replay.path))
+        return false;
+
+    // cubes start with the dimensions of the first frame and are recreated
+    // on fetch when a part of the recording has different ones
+    const rec_codec_dims_t *dims = &s_replay.files[s_replay.frames[0].file].dims;
+
+    s_replay.scratch = malloc(s_replay.max_frame_count * sizeof(uint16_t));
+    s_replay.cubes = calloc(s_replay.max_held_frames, sizeof(ifx_Cube_R_t*));
+    s_replay.held = calloc(s_replay.max_held_frames, sizeof(bool));
+    if((s_replay.scratch == NULL) || (s_replay.cubes == NULL) || (s_replay.held == NULL))
+        return false;
+
+    for(uint32_t i = 0; i < s_replay.max_held_frames; i++) {
+        s_replay.cubes[i] = ifx_cube_create_r(dims->num_antennas,
+            dims->num_chirps_per_frame, dims->num_samples_per_chirp);
+        if(s_replay.cubes[i] == NULL)
+            return false;
+    }
+
+    s_replay.next_frame = 0;
+    s_replay.start_us = monotonic_us();
+    s_replay.start_timestamp_us = s_replay.frames[0].timestamp_us;
+
+    return true;
+}
+
+void acq_stop()
+{
+    if(s_replay.cubes != NULL) {
+        for(uint32_t i = 0; i < s_replay.max_held_frames; i++)
+            ifx_cube_destroy_r(s_replay.cubes[i]);
+    }
+
+    free(s_replay.cubes);
+    free(s_replay.held);
+    free(s_replay.scratch);
+    s_replay.cubes = NULL;
+    s_replay.held = NULL;
+    s_replay.scratch = NULL;
+    s_replay.implicit = NULL;
+
+    close_recording();
+}
+
+/* Waits until the frame is due. Timestamps are wall clock times, so a
+ * backwards step, e.g. from a clock adjustment while recording, restarts the
+ * pacing at that frame. */
+static void pace(const replay_frame_t *frame)
+{
+    if(frame->timestamp_us < s_replay.start_timestamp_us) {
+        s_replay.start_us = monotonic_us();
+        s_replay.start_timestamp_us = frame->timestamp_us;
+        return;
+    }
+
+    const uint64_t due_us = s_replay.start_us +
+        (frame->timestamp_us - s_replay.start_timestamp_us) * 100u / s_replay.speed_percent;
+    const uint64_t now_us = monotonic_us();
+
+    if(due_us > now_us) {
+        const uint64_t wait_us = due_us - now_us;
+        struct timespec ts = { (time_t)(wait_us / 1000000u), (long)(wait_us % 1000000u) * 1000 };
+        while((nanosleep(&ts, &ts) != 0) && (errno == EINTR))
+            ;
+    }
+}
+
+/* Returns the cube of the slot with the given dimensions. The slot is held
+ * by the caller, so only acq_release() looks at it concurrently. */
+static ifx_Cube_R_t *slot_cube(uint32_t slot, const rec_codec_dims_t *dims)
+{
+    ifx_Cube_R_t *cube = s_replay.cubes[slot];
+    if((IFX_CUBE_ROWS(cube) == dims->num_antennas) &&
+       (IFX_CUBE_COLS(cube) == dims->num_chirps_per_frame) &&
+       (IFX_CUBE_SLICES(cube) == dims->num_samples_per_chirp))
+        return cube;
+
+    ifx_Cube_R_t *resized = ifx_cube_create_r(dims->num_antennas,
+        dims->num_chirps_per_frame, dims->num_samples_per_chirp);
+    if(resized == NULL)
+        return NULL;
+
+    pthread_mutex_lock(&s_replay.lock);
+    s_replay.cubes[slot] = resized;
+    pthread_mutex_unlock(&s_replay.lock);
+
+    ifx_cube_destroy_r(cube);
+    return resized;
+}
+
+static ifx_Cube_R_t *read_frame(uint32_t slot)
+{
+    if(s_replay.next_frame == s_replay.num_frames) {
+        s_replay.next_frame = 0;
+        s_replay.start_us = monotonic_us();
+        s_replay.start_timestamp_us = s_replay.frames[0].timestamp_us;
+    }
+
+    const replay_frame_t *frame = &s_replay.frames[s_replay.next_frame++];
+
+    const rec_codec_dims_t *dims = &s_replay.files[frame->file].dims;
+
+    ifx_Cube_R_t *cube = slot_cube(slot, dims);
+    if(cube == NULL)
+        return NULL;
+
+    if(s_replay.realtime)
+        pace(frame);
+
+    if(s_replay.header.sample_format == REC_SAMPLE_FLOAT32) {
+        memcpy(IFX_CUBE_DAT(cube), frame->data, frame->size);
+        return cube;
+    }
+
+    if(!rec_codec_decode(dims, frame->data, frame->size, s_replay.scratch, IFX_CUBE_DAT(cube))) {
+        rep_err("frame %zu of the recording is corrupt.\n", s_replay.next_frame - 1);
+        return NULL;
+    }
+
+    return cube;
+}
+
+bool acq_fetch_hold(ifx_Cube_R_t **out)
+{
+    *out = NULL; // already indicate no more data in case anything fails
+
+    if(s_replay.cubes == NULL)
+        return false;
+
+    // the end of the recording is reported as no more data
+    if((s_replay.next_frame == s_replay.num_frames) && !s_replay.loop)
+        return true;
+
+    uint32_t slot = 0;
+
+    pthread_mutex_lock(&s_replay.lock);
+    for(; slot < s_replay.max_held_frames; slot++) {
+        if(!s_replay.held[slot]) {
+            s_replay.held[slot] = true;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&s_replay.lock);
+
+    if(slot == s_replay.max_held_frames) {
+        rep_err("all %u output slots are held, release a frame before fetching the next one.\n",
+            (unsigned)s_replay.max_held_frames);
+        return false;
+    }
+
+    ifx_Cube_R_t *cube = read_frame(slot);
+    if(cube == NULL) {
+        pthread_mutex_lock(&s_replay.lock);
+        s_replay.held[slot] = false;
+        pthread_mutex_unlock(&s_replay.lock);
+        return false;
+    }
+
+    *out = cube;
+    return true;
+}
+
+void acq_release(ifx_Cube_R_t *frame)
+{
+    if((frame == NULL) || (s_replay.cubes == NULL))
+        return;
+
+    pthread_mutex_lock(&s_replay.lock);
+    for(uint32_t slot = 0; slot < s_replay.max_held_frames; slot++) {
+        if(s_replay.cubes[slot] == frame)
+            s_replay.held[slot] = false;
+    }
+    pthread_mutex_unlock(&s_replay.lock);
+}
+
+bool acq_fetch(ifx_Cube_R_t **out)
+{
+    if(s_replay.implicit != NULL) {
+        acq_release(s_replay.implicit);
+        s_replay.implicit = NULL;
+    }
+
+    if(!acq_fetch_hold(out))
+        return false;
+
+    s_replay.implicit = *out;
+    return true;
+}
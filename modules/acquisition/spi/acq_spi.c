@@ -27,13 +27,42 @@
 ** ===========================================================================
 */
 
+// disable warnings about unsafe functions with MSVC
+#ifdef _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
 #include "interface/acquisition.h"
 #include "interface/report.h"
 
 #include "direct.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <string.h>
+#include <math.h>
 
 static bool acq_set_mode(const char *name);
 static bool acq_enable_data_integrity_test(bool enable);
+static bool acq_set_rx_mask(int v);
+static bool acq_set_chirp_start(int v);
+static bool acq_set_chirp_count(int v);
+static bool acq_set_chirp_stride(int v);
+static bool acq_set_sample_start(int v);
+static bool acq_set_sample_count(int v);
+static bool acq_enable_packed_ring(bool enable);
+static bool acq_set_ring_depth(int v);
+static bool acq_set_frame_rate(int v);
+static bool acq_set_max_irq_rate(int v);
+static bool acq_set_max_latency(int v);
+static bool acq_set_calibration(const char *path);
+static bool acq_set_window(const char *name);
+static bool acq_set_window_attenuation(int v);
+static bool acq_set_flight_recorder_seconds(int v);
+static bool acq_set_flight_recorder_prefix(const char *path);
+static bool acq_enable_flight_recorder_signal(bool enable);
+static bool acq_set_bus_name(const char *name);
+static bool acq_set_bus_slots(int v);
 
 static const app_option_t acq_options[] = {
     APP_OPTION_STRING(
@@ -44,6 +73,82 @@ static const app_option_t acq_options[] = {
         "data_integrity_test",
         "enable spi data integrity test (all data trasnfered to the algo will be 0 if enabled)",
         acq_enable_data_integrity_test),
+    APP_OPTION_INT(
+        "rx_mask",
+        "bit mask of the rx antennas to process (bit 0 = RX1), 0 for all",
+        acq_set_rx_mask),
+    APP_OPTION_INT(
+        "chirp_start",
+        "first chirp of each frame to process",
+        acq_set_chirp_start),
+    APP_OPTION_INT(
+        "chirp_count",
+        "number of chirps to process, 0 for all remaining",
+        acq_set_chirp_count),
+    APP_OPTION_INT(
+        "chirp_stride",
+        "only process every n-th chirp",
+        acq_set_chirp_stride),
+    APP_OPTION_INT(
+        "sample_start",
+        "first sample of each chirp to process",
+        acq_set_sample_start),
+    APP_OPTION_INT(
+        "sample_count",
+        "number of samples per chirp to process, 0 for all remaining",
+        acq_set_sample_count),
+    APP_OPTION_BOOL(
+        "packed_ring",
+        "keep frames packed in the ring buffer and unpack them when fetched",
+        acq_enable_packed_ring),
+    APP_OPTION_INT(
+        "ring_depth",
+        "number of frames buffered between spi thread and processing",
+        acq_set_ring_depth),
+    APP_OPTION_INT(
+        "frame_rate",
+        "frame rate in Hz of the selected mode, needed for FIFO slice size selection",
+        acq_set_frame_rate),
+    APP_OPTION_INT(
+        "max_irq_rate",
+        "choose the FIFO slice size to stay below this many interrupts per second",
+        acq_set_max_irq_rate),
+    APP_OPTION_INT(
+        "max_latency_us",
+        "choose the FIFO slice size so a slice is filled within this many microseconds",
+        acq_set_max_latency),
+    APP_OPTION_PATH(
+        "calibration",
+        "file with per antenna lines 'rx offset gain' and/or per sample lines 'rx sample offset gain'",
+        acq_set_calibration),
+    APP_OPTION_STRING(
+        "window",
+        "window applied to the samples of each chirp while converting: hann, hamming, blackmanharris or chebyshev",
+        acq_set_window),
+    APP_OPTION_INT(
+        "window_at_db",
+        "side lobe attenuation of the chebyshev window in dB",
+        acq_set_window_attenuation),
+    APP_OPTION_INT(
+        "flight_recorder_s",
+        "keep the last n seconds of raw frames in memory for dumps on trigger, needs frame_rate",
+        acq_set_flight_recorder_seconds),
+    APP_OPTION_PATH(
+        "flight_recorder_prefix",
+        "path prefix of the flight recorder dump files",
+        acq_set_flight_recorder_prefix),
+    APP_OPTION_BOOL(
+        "flight_recorder_signal",
+        "dump the flight recorder when SIGUSR1 is received",
+        acq_enable_flight_recorder_signal),
+    APP_OPTION_STRING(
+        "bus",
+        "publish frames for other processes on the shared memory frame bus with this name, e.g. /radar",
+        acq_set_bus_name),
+    APP_OPTION_INT(
+        "bus_slots",
+        "number of frames in the frame bus ring",
+        acq_set_bus_slots),
     APP_OPTION_END
 };
 
@@ -52,6 +157,21 @@ const app_cmdarg_t acq_adesc = { "spi", "spi based data acquisition", acq_option
 static const direct_mode_description_t *mode = 
     &direct_device_default_mode_table[0];
 
+static direct_slicing_config_t slicing = { 0, 0, 0 };
+
+static direct_subset_t subset = { 0, 0, 0, 0, 0, 0 };
+
+static const char *calibration_path = NULL;
+
+static bool window_enabled = false;
+static ifx_Window_Config_t window = { IFX_WINDOW_HANN, 0, 60, 1 };
+
+static int flight_recorder_seconds = 0;
+static const char *flight_recorder_prefix = NULL;
+static bool flight_recorder_signal = false;
+
+static direct_bus_config_t bus = { NULL, 0 };
+
 void acq_init()
 {
     direct_device_init();
@@ -88,9 +208,306 @@ bool acq_enable_data_integrity_test(bool enable)
     return true;
 }
 
+static bool acq_set_subset_field(uint32_t *field, int v)
+{
+    if(v < 0) {
+        rep_err("data subset values must not be negative.\n");
+        return false;
+    }
+
+    *field = (uint32_t)v;
+    return direct_device_configure_subset(&subset);
+}
+
+bool acq_set_rx_mask(int v)
+{
+    return acq_set_subset_field(&subset.antenna_mask, v);
+}
+
+bool acq_set_chirp_start(int v)
+{
+    return acq_set_subset_field(&subset.chirp_start, v);
+}
+
+bool acq_set_chirp_count(int v)
+{
+    return acq_set_subset_field(&subset.chirp_count, v);
+}
+
+bool acq_set_chirp_stride(int v)
+{
+    return acq_set_subset_field(&subset.chirp_stride, v);
+}
+
+bool acq_set_sample_start(int v)
+{
+    return acq_set_subset_field(&subset.sample_start, v);
+}
+
+bool acq_set_sample_count(int v)
+{
+    return acq_set_subset_field(&subset.sample_count, v);
+}
+
+bool acq_enable_packed_ring(bool enable)
+{
+    direct_device_configure_packed_storage(enable);
+    return true;
+}
+
+bool acq_set_ring_depth(int v)
+{
+    if(v <= 0) {
+        rep_err("ring depth must be positive.\n");
+        return false;
+    }
+
+    direct_device_configure_ring_depth((uint32_t)v);
+    return true;
+}
+
+bool acq_set_frame_rate(int v)
+{
+    if(v <= 0) {
+        rep_err("frame rate must be positive.\n");
+        return false;
+    }
+
+    slicing.frame_rate_Hz = (ifx_Float_t)v;
+    direct_device_configure_slicing(&slicing);
+    return true;
+}
+
+bool acq_set_max_irq_rate(int v)
+{
+    slicing.max_interrupt_rate_Hz = (ifx_Float_t)v;
+    direct_device_configure_slicing(&slicing);
+    return true;
+}
+
+bool acq_set_max_latency(int v)
+{
+    slicing.max_latency_s = (ifx_Float_t)v / 1000000;
+    direct_device_configure_slicing(&slicing);
+    return true;
+}
+
+bool acq_set_calibration(const char *path)
+{
+    calibration_path = path;
+    return true;
+}
+
+/* Converts an index read from the calibration file, which must be integral
+ * and below limit. */
+static bool calibration_index(double v, uint32_t limit, uint32_t *index)
+{
+    // also false for NaN
+    if(!((v >= 0) && (v < limit) && (v == floor(v))))
+        return false;
+
+    *index = (uint32_t)v;
+    return true;
+}
+
+/* Reads the calibration file. Lines hold either 'rx offset gain', which
+ * applies to all samples of the antenna, or 'rx sample offset gain'. Later
+ * lines override earlier ones, everything not listed stays uncalibrated.
+ * Empty lines and lines starting with '#' are ignored. */
+static bool acq_load_calibration(const char *path)
+{
+    const uint32_t num_antennas = mode->num_antennas;
+    const uint32_t num_samples = mode->seg_config.num_samples_per_chirp;
+    const size_t count = (size_t)num_antennas * num_samples;
+    bool ok = false;
+
+    FILE *f = fopen(path, "r");
+    if(f == NULL) {
+        rep_err("Could not open calibration file '%s'.\n", path);
+        return false;
+    }
+
+    ifx_Float_t *offset = malloc(count * sizeof(ifx_Float_t));
+    ifx_Float_t *gain = malloc(count * sizeof(ifx_Float_t));
+    if((offset == NULL) || (gain == NULL))
+        goto out;
+
+    for(size_t i = 0; i < count; i++) {
+        offset[i] = 0;
+        gain[i] = 1;
+    }
+
+    char line[256];
+    unsigned line_number = 0;
+    while(fgets(line, sizeof(line), f) != NULL) {
+        double v[5] = { 0 };
+        int n = 0;
+        char *pos = line;
+        line_number++;
+
+        while(*pos == ' ' || *pos == '\t')
+            pos++;
+        if(*pos == '#')
+            continue;
+
+        for(char *end; n < 5; n++, pos = end) {
+            v[n] = strtod(pos, &end);
+            if(end == pos)
+                break;
+        }
+
+        if(n == 0)
+            continue;
+
+        uint32_t rx = 0;
+        uint32_t sample = 0;
+
+        if((n == 4) && calibration_index(v[0], num_antennas, &rx) &&
+           calibration_index(v[1], num_samples, &sample)) {
+            offset[rx * num_samples + sample] = (ifx_Float_t)v[2];
+            gain[rx * num_samples + sample] = (ifx_Float_t)v[3];
+        }
+        else if((n == 3) && calibration_index(v[0], num_antennas, &rx)) {
+            for(uint32_t s = 0; s < num_samples; s++) {
+                offset[rx * num_samples + s] = (ifx_Float_t)v[1];
+                gain[rx * num_samples + s] = (ifx_Float_t)v[2];
+            }
+        }
+        else {
+            rep_err("%s:%u: expected 'rx offset gain' or 'rx sample offset gain' "
+                "with integral indices within the %u antennas and %u samples of the mode.\n",
+                path, line_number, (unsigned)num_antennas, (unsigned)num_samples);
+            goto out;
+        }
+    }
+
+    const direct_calibration_t calibration = { num_antennas, num_samples, offset, gain };
+    ok = direct_device_configure_calibration(&calibration);
+
+out:
+    fclose(f);
+    free(offset);
+    free(gain);
+    return ok;
+}
+
+bool acq_set_flight_recorder_seconds(int v)
+{
+    if(v < 0) {
+        rep_err("flight recorder duration must not be negative.\n");
+        return false;
+    }
+
+    flight_recorder_seconds = v;
+    return true;
+}
+
+bool acq_set_flight_recorder_prefix(const char *path)
+{
+    flight_recorder_prefix = path;
+    return true;
+}
+
+bool acq_enable_flight_recorder_signal(bool enable)
+{
+    flight_recorder_signal = enable;
+    return true;
+}
+
+bool acq_set_bus_name(const char *name)
+{
+    bus.name = name;
+    return direct_device_configure_bus(&bus);
+}
+
+bool acq_set_bus_slots(int v)
+{
+    if(v <= 0) {
+        rep_err("number of frame bus slots must be positive.\n");
+        return false;
+    }
+
+    bus.num_slots = (uint32_t)v;
+    return direct_device_configure_bus(&bus);
+}
+
+bool acq_set_window(const char *name)
+{
+    static const struct {
+        const char *name;
+        ifx_Window_Type_t type;
+    } types[] = {
+        { "hann", IFX_WINDOW_HANN },
+        { "hamming", IFX_WINDOW_HAMM },
+        { "blackmanharris", IFX_WINDOW_BLACKMANHARRIS },
+        { "chebyshev", IFX_WINDOW_CHEBYSHEV },
+    };
+
+    for(size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+        if(strcmp(name, types[i].name) == 0) {
+            window.type = types[i].type;
+            window_enabled = true;
+            return direct_device_configure_window(&window);
+        }
+    }
+
+    rep_err("Window '%s' not understood, use hann, hamming, blackmanharris or chebyshev.\n", name);
+    return false;
+}
+
+bool acq_set_window_attenuation(int v)
+{
+    if(v <= 0) {
+        rep_err("window attenuation must be positive.\n");
+        return false;
+    }
+
+    window.at_dB = (ifx_Float_t)v;
+    return window_enabled ? direct_device_configure_window(&window) : true;
+}
+
+#ifdef SIGUSR1
+static void acq_flight_recorder_signal_handler(int sig)
+{
+    if(sig == SIGUSR1)
+        direct_device_flight_recorder_trigger();
+}
+#endif
+
+static bool acq_setup_flight_recorder()
+{
+    direct_flight_recorder_config_t config = { 0, flight_recorder_prefix };
+
+    if(flight_recorder_seconds > 0) {
+        if(slicing.frame_rate_Hz <= 0) {
+            rep_err("the flight recorder needs the frame rate to size its buffer.\n");
+            return false;
+        }
+        config.num_frames = (uint32_t)ceil(flight_recorder_seconds * slicing.frame_rate_Hz);
+    }
+
+    if(!direct_device_configure_flight_recorder(&config))
+        return false;
+
+    if(flight_recorder_signal) {
+#ifdef SIGUSR1
+        signal(SIGUSR1, acq_flight_recorder_signal_handler);
+#else
+        rep_err("signals to trigger the flight recorder are not supported on this platform.\n");
+        return false;
+#endif
+    }
+
+    return true;
+}
 
 bool acq_start()
 {
+    if((calibration_path != NULL) && !acq_load_calibration(calibration_path))
+        return false;
+
+    if(!acq_setup_flight_recorder())
+        return false;
 
     if(! direct_device_start(mode)) {
         rep_err("failed to start direct device data fetching.\n");
@@ -109,3 +526,19 @@ bool acq_fetch(ifx_Cube_R_t **out)
 {
     return direct_device_acq_fetch(out);
 }
+
+bool acq_fetch_hold(ifx_Cube_R_t **out)
+{
+    return direct_device_acq_fetch_hold(out);
+}
+
+void acq_release(ifx_Cube_R_t *frame)
+{
+    direct_device_acq_release(frame);
+}
+
+bool acq_set_max_held_frames(uint32_t num_frames)
+{
+    direct_device_configure_output_slots(num_frames);
+    return true;
+}
@@ -0,0 +1,336 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#include "interface/record_async.h"
+#include "interface/record.h"
+#include "interface/acquisition.h"
+#include "interface/report.h"
+
+#include <pthread.h>
+#include <time.h>
+
+typedef enum {
+    REC_POLICY_BLOCK,       /* wait for the recorder, backpressure goes to the ring */
+    REC_POLICY_DROP_OLDEST, /* drop the oldest queued frame */
+    REC_POLICY_DROP_NEWEST, /* drop the frame which is submitted */
+} rec_policy_t;
+
+static bool s_enabled = false;
+static uint32_t s_queue_depth = 8;
+static rec_policy_t s_policy = REC_POLICY_BLOCK;
+static uint32_t s_stats_interval_s = 0;
+
+static struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    bool running;
+    bool quit;
+    bool failed;
+
+    ifx_Cube_R_t **queue;
+    uint32_t head;
+    uint32_t count;
+
+    /* statistics, protected by lock */
+    uint64_t frames_written;
+    uint64_t frames_dropped;
+    uint32_t max_count;
+    double write_time_s;
+    double max_write_time_s;
+} s_rec;
+
+static bool set_enable(bool v)
+{
+    s_enabled = v;
+    return true;
+}
+
+static bool set_queue_depth(int v)
+{
+    if(v <= 0) {
+        rep_err("recording queue depth must be positive.\n");
+        return false;
+    }
+
+    s_queue_depth = (uint32_t)v;
+    return true;
+}
+
+static bool set_policy(const char *v)
+{
+    if(strcmp(v, "block") == 0)
+        s_policy = REC_POLICY_BLOCK;
+    else if(strcmp(v, "drop_oldest") == 0)
+        s_policy = REC_POLICY_DROP_OLDEST;
+    else if(strcmp(v, "drop_newest") == 0)
+        s_policy = REC_POLICY_DROP_NEWEST;
+    else {
+        rep_err("Recording policy '%s' not understood.\n", v);
+        return false;
+    }
+
+    return true;
+}
+
+static bool set_stats_interval(int v)
+{
+    s_stats_interval_s = (v > 0) ? (uint32_t)v : 0;
+    return true;
+}
+
+static const app_option_t rec_async_options[] = {
+    APP_OPTION_BOOL(
+        "enable",
+        "record on a separate thread",
+        set_enable),
+    APP_OPTION_INT(
+        "queue_depth",
+        "number of frames queued for the recording thread",
+        set_queue_depth),
+    APP_OPTION_STRING(
+        "policy",
+        "what to do if the queue is full (block, drop_oldest, drop_newest)",
+        set_policy),
+    APP_OPTION_INT(
+        "stats_interval_s",
+        "report recording statistics every n seconds, 0 only at the end",
+        set_stats_interval),
+    APP_OPTION_END
+};
+
+const app_cmdarg_t rec_async_adesc = { "recq", "asynchronous recording", rec_async_options };
+
+static double now_s()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* needs s_rec.lock */
+static void report_stats(double elapsed_s)
+{
+    const double rate = (elapsed_s > 0) ? (double)s_rec.frames_written / elapsed_s : 0;
+    const double avg_ms = (s_rec.frames_written > 0)
+        ? 1000 * s_rec.write_time_s / (double)s_rec.frames_written
+        : 0;
+
+    rep_msg("recording: %llu frames written (%.1f frames/s, write %.2f ms avg %.2f ms max), "
+        "%llu dropped, queue %u/%u (max %u)\n",
+        (unsigned long long)s_rec.frames_written, rate, avg_ms, 1000 * s_rec.max_write_time_s,
+        (unsigned long long)s_rec.frames_dropped,
+        (unsigned)s_rec.count, (unsigned)s_queue_depth, (unsigned)s_rec.max_count);
+}
+
+static void *record_thread(void *arg)
+{
+    (void)arg;
+    const double start = now_s();
+    double next_report = start + s_stats_interval_s;
+
+    pthread_mutex_lock(&s_rec.lock);
+
+    for(;;) {
+        while((s_rec.count == 0) && !s_rec.quit)
+            pthread_cond_wait(&s_rec.not_empty, &s_rec.lock);
+
+        if(s_rec.count == 0)
+            break;
+
+        ifx_Cube_R_t *frame = s_rec.queue[s_rec.head];
+        s_rec.head = (s_rec.head + 1) % s_queue_depth;
+        s_rec.count--;
+        pthread_cond_signal(&s_rec.not_full);
+
+        // once recording failed, frames are only given back
+        const bool skip = s_rec.failed;
+
+        pthread_mutex_unlock(&s_rec.lock);
+
+        const double t0 = now_s();
+        const bool ok = skip || record_radar_frame(frame);
+        const double t1 = now_s();
+        acq_release(frame);
+
+        pthread_mutex_lock(&s_rec.lock);
+
+        if(!ok) {
+            s_rec.failed = true;
+            pthread_cond_broadcast(&s_rec.not_full);
+        }
+        else if(!skip) {
+            s_rec.frames_written++;
+            s_rec.write_time_s += t1 - t0;
+            if(t1 - t0 > s_rec.max_write_time_s)
+                s_rec.max_write_time_s = t1 - t0;
+        }
+
+        if((s_stats_interval_s > 0) && (t1 >= next_report)) {
+            report_stats(t1 - start);
+            next_report = t1 + s_stats_interval_s;
+        }
+    }
+
+    report_stats(now_s() - start);
+    pthread_mutex_unlock(&s_rec.lock);
+
+    return NULL;
+}
+
+void record_async_init()
+{
+    s_rec.running = false;
+    s_rec.queue = NULL;
+}
+
+void record_async_deinit()
+{
+    record_async_stop();
+}
+
+bool record_async_enabled()
+{
+    return s_enabled;
+}
+
+uint32_t record_async_max_held_frames()
+{
+    return s_queue_depth + 2;
+}
+
+bool record_async_start()
+{
+    record_async_stop();
+
+    if(!s_enabled)
+        return true;
+
+    s_rec.queue = calloc(s_queue_depth, sizeof(ifx_Cube_R_t *));
+    if(s_rec.queue == NULL) {
+        rep_err("failed to allocate the recording queue.\n");
+        return false;
+    }
+
+    s_rec.head = 0;
+    s_rec.count = 0;
+    s_rec.quit = false;
+    s_rec.failed = false;
+    s_rec.frames_written = 0;
+    s_rec.frames_dropped = 0;
+    s_rec.max_count = 0;
+    s_rec.write_time_s = 0;
+    s_rec.max_write_time_s = 0;
+
+    pthread_mutex_init(&s_rec.lock, NULL);
+    pthread_cond_init(&s_rec.not_empty, NULL);
+    pthread_cond_init(&s_rec.not_full, NULL);
+
+    if(pthread_create(&s_rec.thread, NULL, record_thread, NULL) != 0) {
+        rep_err("failed to start the recording thread.\n");
+        pthread_cond_destroy(&s_rec.not_full);
+        pthread_cond_destroy(&s_rec.not_empty);
+        pthread_mutex_destroy(&s_rec.lock);
+        free(s_rec.queue);
+        s_rec.queue = NULL;
+        return false;
+    }
+
+    s_rec.running = true;
+    return true;
+}
+
+void record_async_stop()
+{
+    if(!s_rec.running)
+        return;
+
+    pthread_mutex_lock(&s_rec.lock);
+    s_rec.quit = true;
+    pthread_cond_signal(&s_rec.not_empty);
+    pthread_mutex_unlock(&s_rec.lock);
+
+    pthread_join(s_rec.thread, NULL);
+
+    pthread_cond_destroy(&s_rec.not_full);
+    pthread_cond_destroy(&s_rec.not_empty);
+    pthread_mutex_destroy(&s_rec.lock);
+    free(s_rec.queue);
+    s_rec.queue = NULL;
+    s_rec.running = false;
+}
+
+bool record_async_submit(ifx_Cube_R_t *frame)
+{
+    ifx_Cube_R_t *dropped = NULL;
+
+    pthread_mutex_lock(&s_rec.lock);
+
+    if(s_policy == REC_POLICY_BLOCK) {
+        while((s_rec.count == s_queue_depth) && !s_rec.failed)
+            pthread_cond_wait(&s_rec.not_full, &s_rec.lock);
+    }
+    else if(s_rec.count == s_queue_depth) {
+        s_rec.frames_dropped++;
+
+        if(s_policy == REC_POLICY_DROP_NEWEST) {
+            dropped = frame;
+            frame = NULL;
+        }
+        else {
+            dropped = s_rec.queue[s_rec.head];
+            s_rec.head = (s_rec.head + 1) % s_queue_depth;
+            s_rec.count--;
+        }
+    }
+
+    const bool ok = !s_rec.failed;
+
+    if(ok && (frame != NULL)) {
+        s_rec.queue[(s_rec.head + s_rec.count) % s_queue_depth] = frame;
+        s_rec.count++;
+        if(s_rec.count > s_rec.max_count)
+            s_rec.max_count = s_rec.count;
+        pthread_cond_signal(&s_rec.not_empty);
+    }
+    else if(frame != NULL) {
+        dropped = frame;
+    }
+
+    pthread_mutex_unlock(&s_rec.lock);
+
+    if(dropped != NULL)
+        acq_release(dropped);
+
+    if(!ok)
+        rep_err("Recording data to file failed.\n");
+
+    return ok;
+}
@@ -32,22 +32,79 @@
 #include "interface/report.h"
 #include "interface/acquisition.h"
 #include "interface/record.h"
+#include "interface/record_async.h"
 #include "interface/app_utils.h"
 #include "interface/app_argparse.h"
 #include "ifxBase/Error.h"
+#include "ifxBase/MTI.h"
 
 static uint32_t frame_limit = 0;
 
+static bool mti_enabled = false;
+static ifx_MTI_Config_t mti_config = { IFX_MTI_MEAN_CHIRP, 0, 0, 0, 0.05f };
+static ifx_MTI_t *mti = NULL;
+
 static bool set_frames(int v) {
     frame_limit = v;
     return true;
 }
 
+static bool set_mti(const char *mode) {
+    if(strcmp(mode, "mean") == 0)
+        mti_config.mode = IFX_MTI_MEAN_CHIRP;
+    else if(strcmp(mode, "background") == 0)
+        mti_config.mode = IFX_MTI_BACKGROUND;
+    else {
+        rep_err("MTI mode '%s' not understood, use mean or background.\n", mode);
+        return false;
+    }
+
+    mti_enabled = true;
+    return true;
+}
+
+static bool set_mti_alpha(int v) {
+    if((v <= 0) || (v > 100)) {
+        rep_err("MTI alpha must be between 1 and 100 percent.\n");
+        return false;
+    }
+
+    mti_config.alpha = v / 100.0f;
+    return true;
+}
+
+/* The stage is sized by the first frame, the data source knows the
+ * dimensions only once it is running */
+static bool remove_clutter(ifx_Cube_R_t *frame) {
+    if(mti == NULL) {
+        mti_config.num_samples_per_chirp = IFX_CUBE_SLICES(frame);
+        mti_config.num_antennas = IFX_CUBE_ROWS(frame);
+        mti_config.num_chirps_per_frame = IFX_CUBE_COLS(frame);
+
+        mti = ifx_mti_create(&mti_config);
+        if(mti == NULL) {
+            rep_err("failed to create the MTI stage.\n");
+            return false;
+        }
+    }
+
+    ifx_mti_run(mti, frame, frame);
+    return ifx_error_get() == IFX_OK;
+}
+
 static const app_option_t run_options[] = {
     APP_OPTION_INT(
         "frame_limit",
         "maximum number of frames to process",
         set_frames),
+    APP_OPTION_STRING(
+        "mti",
+        "remove static clutter from every frame before it is recorded: mean (chirp mean of the frame) or background (exponential average over frames)",
+        set_mti),
+    APP_OPTION_INT(
+        "mti_alpha_pct",
+        "weight of the newest frame in the MTI background in percent",
+        set_mti_alpha),
     APP_OPTION_END
 };
 
@@ -56,6 +113,7 @@ static const app_cmdarg_t run_adesc = { "run", "run configuration", run_options
 static const app_cmdarg_t *argdesc[] = {
     &acq_adesc,
     &rec_adesc,
+    &rec_async_adesc,
     &run_adesc,
     NULL
 };
@@ -67,6 +125,7 @@ int main(int argc, char* argv[])
     rep_init();
     acq_init();
     record_init();
+    record_async_init();
 
     if(! app_parse_opts(argdesc, argc, argv))
         goto cleanup;
@@ -77,6 +136,13 @@ int main(int argc, char* argv[])
     if (!record_start())
         goto cleanup;
 
+    // frames queued for recording are held until they have been written
+    if (record_async_enabled() && !acq_set_max_held_frames(record_async_max_held_frames()))
+        goto cleanup;
+
+    if (!record_async_start())
+        goto cleanup;
+
     if(!acq_start()) {
         rep_err("failed to start data acquisition\n");
         goto cleanup;
@@ -89,8 +155,11 @@ int main(int argc, char* argv[])
     while (!abort_requested())
     {
         ifx_Cube_R_t *radar_data_frame = NULL;
+        const bool fetched = record_async_enabled()
+            ? acq_fetch_hold(&radar_data_frame)
+            : acq_fetch(&radar_data_frame);
 
-        if(!acq_fetch(&radar_data_frame)) {
+        if(!fetched) {
             rep_err("Data source indicated an error when fetching data\n");
             goto cleanup;
         }
@@ -99,7 +168,14 @@ int main(int argc, char* argv[])
             break;
         }
 
-        if(! record_radar_frame(radar_data_frame))
+        if(mti_enabled && ! remove_clutter(radar_data_frame))
+            goto cleanup;
+
+        if(record_async_enabled()) {
+            if(! record_async_submit(radar_data_frame))
+                goto cleanup;
+        }
+        else if(! record_radar_frame(radar_data_frame))
             goto cleanup;
 
         rep_mark_frame_processing_start();
@@ -114,6 +190,8 @@ int main(int argc, char* argv[])
     // everything successful
     exitcode = EXIT_SUCCESS;
 cleanup:
+    ifx_mti_destroy(mti);
+    record_async_deinit();
     record_deinit();
     acq_deinit();
     rep_deinit();
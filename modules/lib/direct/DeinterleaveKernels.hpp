@@ -0,0 +1,255 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+/**
+ * @file DeinterleaveKernels.hpp
+ *
+ * @brief Conversion of raw FIFO frames into output cubes
+ *
+ * The FIFO delivers the samples of a frame chirp by chirp, interleaved per
+ * antenna: sample0_RX1, sample0_RX2, sample1_RX1, sample1_RX2, ...
+ * The output cube is laid out as [sample][rx][chirp], so the conversion is a
+ * transpose of a num_chirps x (num_samples * num_rx) matrix.
+ *
+ * For the dimensions listed in deinterleave_dims the transpose is compiled
+ * with all dimensions known, every other mode or a subset selection uses
+ * the generic kernel. direct_device_init() reports default modes which are
+ * missing from the list.
+ *
+ * With calibration each value is converted as raw * scale[k] + bias[k] with
+ * k = sample * num_rx + rx, the output row of the value. The tables fold the
+ * ADC normalization, DC offset and gain into one multiply-add.
+ */
+
+#ifndef DEINTERLEAVE_KERNELS_HPP
+#define DEINTERLEAVE_KERNELS_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+#include "ifxBase/Types.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/* Subset of the acquired data which is converted to the output cube,
+ * resolved against the mode */
+struct selection_t {
+    uint8_t rx[32];
+    uint32_t num_rx;
+    uint32_t chirp_start;
+    uint32_t chirp_stride;
+    uint32_t num_chirps;
+    uint32_t sample_start;
+    uint32_t num_samples;
+};
+
+/* Converts the raw frame in buffer into out, which holds
+ * selection.num_samples x selection.num_rx x selection.num_chirps values.
+ * scale and bias are the calibration tables, unused by uncalibrated kernels. */
+typedef void (*deinterleave_kernel_t)(const uint16_t* buffer, const selection_t& selection,
+    uint32_t num_rx, uint32_t num_samples_per_chirp,
+    const ifx_Float_t* scale, const ifx_Float_t* bias, ifx_Float_t* out);
+
+struct deinterleave_dims_t {
+    uint32_t num_rx;
+    uint32_t num_chirps_per_frame;
+    uint32_t num_samples_per_chirp;
+};
+
+/* Frame dimensions with a specialized kernel. This mirrors
+ * direct_device_default_mode_table, plus the same segmentation with all
+ * three RX antennas of the BGT60TR13C enabled. Keep it in sync with the
+ * table, a default mode without an entry is reported at init. */
+constexpr deinterleave_dims_t deinterleave_dims[] = {
+    { 2, 64, 128 },     // landscape, landscape-1ghz
+    { 3, 64, 128 },
+};
+
+constexpr ifx_Float_t deinterleave_adc_max = 4095;
+
+/* Number of chirps transposed together, so that every output row is written
+ * in runs of this many consecutive values */
+constexpr uint32_t deinterleave_chirp_block = 8;
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+template<bool CALIBRATED>
+static inline ifx_Float_t deinterleave_convert(uint16_t raw, const ifx_Float_t* scale,
+    const ifx_Float_t* bias, size_t k)
+{
+    if (CALIBRATED)
+        return raw * scale[k] + bias[k];
+    else
+        return raw / deinterleave_adc_max;
+}
+
+//----------------------------------------------------------------------------
+
+template<bool CALIBRATED>
+static void deinterleave_generic(const uint16_t* buffer, const selection_t& sel,
+    uint32_t num_rx, uint32_t num_samples_per_chirp,
+    const ifx_Float_t* scale, const ifx_Float_t* bias, ifx_Float_t* out)
+{
+    const size_t slice_size = (size_t)sel.num_rx * sel.num_chirps;
+
+    for(size_t r = 0; r < sel.num_rx; r++)
+    {
+        const size_t rx = sel.rx[r];
+
+        for (size_t c = 0; c < sel.num_chirps; c++)
+        {
+            const size_t chirp = sel.chirp_start + c * sel.chirp_stride;
+            const size_t chirp_offset = chirp * num_rx * num_samples_per_chirp;
+
+            for (size_t s = 0; s < sel.num_samples; s++)
+            {
+                // sample0_RX1 sample0_RX2, sample1_RX1, sample2_RX2, ...
+                const size_t sample_offset = (sel.sample_start + s) * num_rx;
+                const size_t index = rx + sample_offset + chirp_offset;
+                out[slice_size * s + sel.num_chirps * r + c] =
+                    deinterleave_convert<CALIBRATED>(buffer[index], scale, bias, s * sel.num_rx + r);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+template<uint32_t NUM_RX, uint32_t NUM_CHIRPS, uint32_t NUM_SAMPLES, bool CALIBRATED>
+static void deinterleave_fixed(const uint16_t* buffer, const selection_t&,
+    uint32_t, uint32_t, const ifx_Float_t* scale, const ifx_Float_t* bias, ifx_Float_t* out)
+{
+    // chirp c of the FIFO data is column c of the output, the position of a
+    // value within the chirp (s * NUM_RX + rx) is the output row
+    constexpr uint32_t row_length = NUM_RX * NUM_SAMPLES;
+    constexpr uint32_t block = deinterleave_chirp_block;
+    constexpr uint32_t full_blocks = NUM_CHIRPS / block;
+
+    for (uint32_t b = 0; b < full_blocks; b++)
+    {
+        const uint16_t* src = buffer + (size_t)b * block * row_length;
+        ifx_Float_t* dst = out + (size_t)b * block;
+
+        for (uint32_t i = 0; i < row_length; i++)
+        {
+            for (uint32_t j = 0; j < block; j++)
+                dst[(size_t)i * NUM_CHIRPS + j] =
+                    deinterleave_convert<CALIBRATED>(src[(size_t)j * row_length + i], scale, bias, i);
+        }
+    }
+
+    for (uint32_t c = full_blocks * block; c < NUM_CHIRPS; c++)
+    {
+        const uint16_t* src = buffer + (size_t)c * row_length;
+
+        for (uint32_t i = 0; i < row_length; i++)
+            out[(size_t)i * NUM_CHIRPS + c] = deinterleave_convert<CALIBRATED>(src[i], scale, bias, i);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+template<size_t I, size_t N, bool CALIBRATED>
+struct deinterleave_lookup
+{
+    static deinterleave_kernel_t find(uint32_t num_rx, uint32_t num_chirps, uint32_t num_samples)
+    {
+        constexpr deinterleave_dims_t dims = deinterleave_dims[I];
+
+        if ((num_rx == dims.num_rx) &&
+            (num_chirps == dims.num_chirps_per_frame) &&
+            (num_samples == dims.num_samples_per_chirp))
+        {
+            return &deinterleave_fixed<dims.num_rx, dims.num_chirps_per_frame,
+                dims.num_samples_per_chirp, CALIBRATED>;
+        }
+
+        return deinterleave_lookup<I + 1, N, CALIBRATED>::find(num_rx, num_chirps, num_samples);
+    }
+};
+
+template<size_t N, bool CALIBRATED>
+struct deinterleave_lookup<N, N, CALIBRATED>
+{
+    static deinterleave_kernel_t find(uint32_t, uint32_t, uint32_t)
+    {
+        return nullptr;
+    }
+};
+
+//----------------------------------------------------------------------------
+
+/* Returns the specialized kernel for whole frames of the given dimensions,
+ * or nullptr if there is none */
+static deinterleave_kernel_t deinterleave_find_fixed(uint32_t num_rx,
+    uint32_t num_chirps_per_frame, uint32_t num_samples_per_chirp, bool calibrated)
+{
+    constexpr size_t num_dims = sizeof(deinterleave_dims) / sizeof(deinterleave_dims[0]);
+
+    if (calibrated)
+        return deinterleave_lookup<0, num_dims, true>::find(num_rx, num_chirps_per_frame, num_samples_per_chirp);
+    else
+        return deinterleave_lookup<0, num_dims, false>::find(num_rx, num_chirps_per_frame, num_samples_per_chirp);
+}
+
+//----------------------------------------------------------------------------
+
+/* Picks the kernel for a run. The specialized kernels convert whole frames,
+ * so they are only used if the selection covers all acquired data. */
+static deinterleave_kernel_t deinterleave_select_kernel(const selection_t& sel,
+    uint32_t num_rx, uint32_t num_chirps_per_frame, uint32_t num_samples_per_chirp,
+    bool calibrated)
+{
+    bool whole_frame = (sel.num_rx == num_rx) &&
+        (sel.chirp_start == 0) && (sel.chirp_stride == 1) &&
+        (sel.num_chirps == num_chirps_per_frame) &&
+        (sel.sample_start == 0) && (sel.num_samples == num_samples_per_chirp);
+
+    for (uint32_t r = 0; whole_frame && (r < sel.num_rx); r++)
+        whole_frame = (sel.rx[r] == r);
+
+    deinterleave_kernel_t kernel = nullptr;
+
+    if (whole_frame)
+        kernel = deinterleave_find_fixed(num_rx, num_chirps_per_frame, num_samples_per_chirp, calibrated);
+
+    if (kernel == nullptr)
+        kernel = calibrated ? &deinterleave_generic<true> : &deinterleave_generic<false>;
+
+    return kernel;
+}
+
+#endif /* DEINTERLEAVE_KERNELS_HPP */
@@ -0,0 +1,216 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+// disable warnings about unsafe functions with MSVC
+#ifdef _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include "FlightRecorder.hpp"
+#include "interface/report.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+bool FlightRecorder::create(const direct_flight_record_header_t& header, const char* path_prefix)
+{
+    destroy();
+
+    if((header.num_frames == 0) || (header.frame_size == 0))
+        return false;
+
+    m_header = header;
+    m_path_prefix = (path_prefix != NULL) ? path_prefix : "flight";
+
+    // touch all memory now, a page fault while recording would stall the
+    // acquisition thread
+    m_data_size = (size_t)header.num_frames * header.frame_size;
+    m_data = (uint8_t*)calloc(m_data_size, 1);
+    if(m_data == nullptr)
+    {
+        rep_err("failed to allocate %zu bytes for the flight recorder.\n", m_data_size);
+        return false;
+    }
+    m_frames.assign(header.num_frames, direct_flight_record_frame_t{ 0, 0, 0 });
+
+#ifdef __linux__
+    m_locked = (mlock(m_data, m_data_size) == 0);
+    if(!m_locked)
+        rep_msg("flight recorder memory couldn't be locked, it may be swapped out.\n");
+#endif
+
+    m_write_count = 0;
+    m_dumping = false;
+    m_dump_next = 0;
+    m_dump_end = 0;
+    m_trigger_requested = false;
+    m_skipped = 0;
+    m_quit = false;
+    m_writer = std::thread(&FlightRecorder::writer_loop, this);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+void FlightRecorder::destroy()
+{
+    if(m_writer.joinable())
+    {
+        // a dump in progress is completed first
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+        m_cond.notify_all();
+        m_writer.join();
+    }
+
+    if(m_data != nullptr)
+    {
+#ifdef __linux__
+        if(m_locked)
+            munlock(m_data, m_data_size);
+#endif
+        free(m_data);
+        m_data = nullptr;
+        m_data_size = 0;
+        m_locked = false;
+    }
+
+    m_frames.clear();
+}
+
+//----------------------------------------------------------------------------
+
+void FlightRecorder::capture(const void* data, uint32_t frame_number, uint64_t timestamp_us, uint32_t flags)
+{
+    const uint32_t num_frames = m_header.num_frames;
+
+    if(m_trigger_requested.load() && !m_dumping.load())
+    {
+        m_trigger_requested = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_dump_end = m_write_count;
+            m_dump_next = (m_write_count > num_frames) ? m_write_count - num_frames : 0;
+            m_dump_trigger_frame = frame_number;
+            m_dumping = true;
+        }
+        m_cond.notify_all();
+    }
+
+    // the oldest slot is still waiting to be written
+    if(m_dumping.load() && (m_write_count >= num_frames) &&
+       (m_write_count - num_frames >= m_dump_next.load()))
+    {
+        m_skipped++;
+        return;
+    }
+
+    const size_t slot = (size_t)(m_write_count % num_frames);
+    memcpy(m_data + slot * m_header.frame_size, data, m_header.frame_size);
+    m_frames[slot] = direct_flight_record_frame_t{ frame_number, flags, timestamp_us };
+    m_write_count++;
+}
+
+//----------------------------------------------------------------------------
+
+void FlightRecorder::writer_loop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for(;;)
+    {
+        m_cond.wait(lock, [this] { return m_quit || m_dumping.load(); });
+
+        if(m_dumping.load())
+        {
+            lock.unlock();
+            write_window();
+            lock.lock();
+            m_dumping = false;
+        }
+        else if(m_quit)
+        {
+            break;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+bool FlightRecorder::write_window()
+{
+    char path[512];
+    snprintf(path, sizeof(path), "%s-%u.bin", m_path_prefix.c_str(), (unsigned)m_dump_trigger_frame);
+
+    const uint64_t first = m_dump_next.load();
+    const uint64_t end = m_dump_end;
+
+    FILE* f = fopen(path, "wb");
+    if(f == NULL)
+    {
+        rep_err("flight recorder failed to create '%s'.\n", path);
+        m_dump_next = end;
+        return false;
+    }
+
+    direct_flight_record_header_t header = m_header;
+    header.num_frames = (uint32_t)(end - first);
+
+    bool ok = (fwrite(&header, sizeof(header), 1, f) == 1);
+
+    for(uint64_t i = first; ok && (i < end); i++)
+    {
+        const size_t slot = (size_t)(i % m_header.num_frames);
+
+        ok = (fwrite(&m_frames[slot], sizeof(m_frames[slot]), 1, f) == 1) &&
+             (fwrite(m_data + slot * m_header.frame_size, m_header.frame_size, 1, f) == 1);
+
+        // hand the slot back to the acquisition thread
+        m_dump_next = i + 1;
+    }
+
+    m_dump_next = end;
+    ok = (fclose(f) == 0) && ok;
+
+    if(ok)
+        rep_msg("flight recorder wrote %u frames to '%s' (%u frames not recorded while writing).\n",
+            (unsigned)header.num_frames, path, (unsigned)m_skipped.exchange(0));
+    else
+        rep_err("flight recorder failed to write '%s'.\n", path);
+
+    return ok;
+}
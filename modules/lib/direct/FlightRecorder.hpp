@@ -0,0 +1,114 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+/**
+ * @file FlightRecorder.hpp
+ *
+ * @brief Keeps the most recent raw frames in memory and writes them to disk
+ *        when triggered
+ *
+ * The acquisition thread copies every completed frame into a preallocated,
+ * locked circular buffer. A trigger marks the frames currently held as the
+ * window to dump, a background thread then writes them to a file in the
+ * format described by direct_flight_record_header_t. While the dump is in
+ * progress, frames which would overwrite not yet written slots are not
+ * recorded.
+ */
+
+#ifndef FLIGHT_RECORDER_HPP
+#define FLIGHT_RECORDER_HPP
+
+#include <cstdint>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "direct.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+class FlightRecorder
+{
+    std::string m_path_prefix;
+    direct_flight_record_header_t m_header;
+
+    uint8_t* m_data = nullptr;
+    size_t m_data_size = 0;
+    bool m_locked = false;
+    std::vector<direct_flight_record_frame_t> m_frames;
+
+    // number of frames captured so far, frame i lives in slot i % num_frames
+    uint64_t m_write_count = 0;
+
+    // window [m_dump_next, m_dump_end) of frames which still need to be written
+    std::atomic<bool> m_dumping{ false };
+    std::atomic<uint64_t> m_dump_next{ 0 };
+    uint64_t m_dump_end = 0;
+    uint32_t m_dump_trigger_frame = 0;
+
+    std::atomic<bool> m_trigger_requested{ false };
+    std::atomic<uint32_t> m_skipped{ 0 };
+
+    std::thread m_writer;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_quit = false;
+
+    void writer_loop();
+    bool write_window();
+
+public:
+    FlightRecorder() = default;
+    ~FlightRecorder() { destroy(); }
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    bool create(const direct_flight_record_header_t& header, const char* path_prefix);
+    void destroy();
+
+    bool is_active() const { return m_data != nullptr; }
+
+    /* Called from the acquisition thread for every completed frame */
+    void capture(const void* data, uint32_t frame_number, uint64_t timestamp_us, uint32_t flags);
+
+    /* Request a dump of the current window. Only touches an atomic flag, so
+     * it is safe to call from signal handlers and any thread. The window is
+     * taken when the next frame is captured. */
+    void trigger() { m_trigger_requested.store(true); }
+};
+
+#endif /* FLIGHT_RECORDER_HPP */
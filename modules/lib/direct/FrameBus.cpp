@@ -0,0 +1,183 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#include "FrameBus.hpp"
+#include "interface/report.h"
+
+#include <cstring>
+#include <climits>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+
+/* Slots start on cache line boundaries */
+static constexpr size_t bus_alignment = 64;
+
+static size_t align_up(size_t size)
+{
+    return (size + bus_alignment - 1) & ~(bus_alignment - 1);
+}
+
+//----------------------------------------------------------------------------
+
+bool FrameBus::create(const char* name, uint32_t num_slots,
+    uint32_t num_antennas, uint32_t num_chirps_per_frame, uint32_t num_samples_per_chirp)
+{
+    destroy();
+
+    const size_t frame_size = (size_t)num_antennas * num_chirps_per_frame *
+        num_samples_per_chirp * sizeof(ifx_Float_t);
+    const size_t header_size = align_up(sizeof(direct_bus_header_t));
+    const size_t slot_size = align_up(DIRECT_BUS_SLOT_HEADER_SIZE + frame_size);
+
+    if((num_slots == 0) || (slot_size > UINT32_MAX))
+        return false;
+
+    // consumers still attached to a previous object keep their mapping,
+    // they see it closed or, after a crash, no new frames
+    shm_unlink(name);
+
+    const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if(fd < 0)
+    {
+        rep_err("failed to create shared memory '%s' for the frame bus.\n", name);
+        return false;
+    }
+
+    m_map_size = header_size + num_slots * slot_size;
+    bool ok = (ftruncate(fd, (off_t)m_map_size) == 0);
+    if(ok)
+    {
+        void* map = mmap(nullptr, m_map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ok = (map != MAP_FAILED);
+        if(ok)
+            m_map = (uint8_t*)map;
+    }
+    close(fd);
+
+    if(!ok)
+    {
+        rep_err("failed to map %zu bytes of shared memory for the frame bus.\n", m_map_size);
+        shm_unlink(name);
+        return false;
+    }
+
+    // fault in all pages now instead of while publishing
+    memset(m_map, 0, m_map_size);
+
+    m_name = name;
+    m_header = (direct_bus_header_t*)m_map;
+    memcpy(m_header->magic, DIRECT_BUS_MAGIC, sizeof(m_header->magic));
+    m_header->version = DIRECT_BUS_VERSION;
+    m_header->header_size = (uint32_t)header_size;
+    m_header->slot_size = (uint32_t)slot_size;
+    m_header->num_slots = num_slots;
+    m_header->num_antennas = num_antennas;
+    m_header->num_chirps_per_frame = num_chirps_per_frame;
+    m_header->num_samples_per_chirp = num_samples_per_chirp;
+    m_header->frame_size = (uint32_t)frame_size;
+    m_header->publisher_pid = (uint32_t)getpid();
+    __atomic_store_n(&m_header->state, (uint32_t)DIRECT_BUS_STATE_OPEN, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+void FrameBus::destroy()
+{
+    if(m_header == nullptr)
+        return;
+
+    __atomic_store_n(&m_header->state, (uint32_t)DIRECT_BUS_STATE_CLOSED, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&m_header->wake, 1u, __ATOMIC_RELEASE);
+    syscall(SYS_futex, &m_header->wake, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+
+    munmap(m_map, m_map_size);
+    shm_unlink(m_name.c_str());
+
+    m_map = nullptr;
+    m_map_size = 0;
+    m_header = nullptr;
+}
+
+//----------------------------------------------------------------------------
+
+void FrameBus::publish(const ifx_Float_t* data, uint32_t frame_number, uint64_t timestamp_us)
+{
+    const uint64_t sequence = m_header->head + 1;
+    uint8_t* slot_base = m_map + m_header->header_size +
+        (size_t)((sequence - 1) % m_header->num_slots) * m_header->slot_size;
+    direct_bus_slot_t* slot = (direct_bus_slot_t*)slot_base;
+
+    // invalidate the slot before any of its data changes
+    __atomic_store_n(&slot->sequence, (uint64_t)0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    slot->frame_number = frame_number;
+    slot->timestamp_us = timestamp_us;
+    memcpy(slot_base + DIRECT_BUS_SLOT_HEADER_SIZE, data, m_header->frame_size);
+
+    __atomic_store_n(&slot->sequence, sequence, __ATOMIC_RELEASE);
+    __atomic_store_n(&m_header->head, sequence, __ATOMIC_RELEASE);
+
+    // consumers can't register as waiters in the read-only mapping, so the
+    // wake is unconditional. It's a single syscall per frame.
+    __atomic_fetch_add(&m_header->wake, 1u, __ATOMIC_RELEASE);
+    syscall(SYS_futex, &m_header->wake, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+#else
+
+bool FrameBus::create(const char*, uint32_t, uint32_t, uint32_t, uint32_t)
+{
+    rep_err("the frame bus is not supported on this platform.\n");
+    return false;
+}
+
+//----------------------------------------------------------------------------
+
+void FrameBus::destroy()
+{
+}
+
+//----------------------------------------------------------------------------
+
+void FrameBus::publish(const ifx_Float_t*, uint32_t, uint64_t)
+{
+}
+
+#endif
@@ -0,0 +1,80 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+/**
+ * @file FrameBus.hpp
+ *
+ * @brief Publishes fetched frames into the shared memory ring described in
+ *        direct_bus.h
+ */
+
+#ifndef FRAME_BUS_HPP
+#define FRAME_BUS_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+#include <string>
+
+#include "direct_bus.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+class FrameBus
+{
+    std::string m_name;
+    uint8_t* m_map = nullptr;
+    size_t m_map_size = 0;
+    direct_bus_header_t* m_header = nullptr;
+
+public:
+    FrameBus() = default;
+    ~FrameBus() { destroy(); }
+
+    FrameBus(const FrameBus&) = delete;
+    FrameBus& operator=(const FrameBus&) = delete;
+
+    /* Creates the shared memory object, replacing a stale one left behind by
+     * a previous run */
+    bool create(const char* name, uint32_t num_slots,
+        uint32_t num_antennas, uint32_t num_chirps_per_frame, uint32_t num_samples_per_chirp);
+
+    /* Marks the bus closed, wakes all consumers and removes the name */
+    void destroy();
+
+    bool is_active() const { return m_header != nullptr; }
+
+    /* Called by the consumer of the acquisition for every fetched frame */
+    void publish(const ifx_Float_t* data, uint32_t frame_number, uint64_t timestamp_us);
+};
+
+#endif /* FRAME_BUS_HPP */
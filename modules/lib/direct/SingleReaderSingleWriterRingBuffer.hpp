@@ -96,6 +96,23 @@ public:
         return try_push_fn([&value](T& dest) { dest = value; });
     }
 
+    /* Returns the entry the next push will go to, so the writer can fill it in
+     * place, or nullptr if the buffer is full. Publish it with commit_push(). */
+    T* peek_push()
+    {
+        const auto rd_offset = m_rd_offset.load();
+        const auto wr_offset = m_wr_offset.load();
+        if (wr_offset - rd_offset >= m_data.size())
+            return nullptr;
+
+        return &m_data[wr_offset % m_data.size()];
+    }
+
+    void commit_push()
+    {
+        m_wr_offset.store(m_wr_offset.load() + 1u);
+    }
+
     bool try_pop_fn(std::function<void(T &)> fn)
     {
         const auto rd_offset = m_rd_offset.load();
@@ -116,7 +133,7 @@ public:
 
     bool try_pop()
     {
-        return try_pop_fn([](T& value) {});
+        return try_pop_fn([](T&) {});
     }
 
     size_t fill()
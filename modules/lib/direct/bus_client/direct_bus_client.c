@@ -0,0 +1,223 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+/**
+ * @file direct_bus_client.c
+ *
+ * @brief Read-only consumer side of the shared memory frame bus
+ *
+ * Clients only map the ring for reading and never write to it, so any
+ * number of them can attach without the publisher knowing about them. The
+ * read cursor and the count of lost frames are private to each client.
+ */
+
+#include "direct_bus.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+struct direct_bus_client {
+    const uint8_t *map;
+    size_t map_size;
+    const direct_bus_header_t *header;
+    uint64_t cursor;                /* sequence of the next frame to read */
+    uint64_t lost;
+};
+
+static uint64_t monotonic_us()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static const direct_bus_slot_t* get_slot(const direct_bus_client_t *client, uint64_t sequence)
+{
+    const direct_bus_header_t *header = client->header;
+    return (const direct_bus_slot_t*)(client->map + header->header_size +
+        (size_t)((sequence - 1) % header->num_slots) * header->slot_size);
+}
+
+direct_bus_client_t* direct_bus_client_attach(const char *name)
+{
+    const int fd = shm_open(name, O_RDONLY, 0);
+    if(fd < 0)
+        return NULL;
+
+    struct stat st;
+    const uint8_t *map = MAP_FAILED;
+    if((fstat(fd, &st) == 0) && ((size_t)st.st_size >= sizeof(direct_bus_header_t)))
+        map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if(map == MAP_FAILED)
+        return NULL;
+
+    const direct_bus_header_t *header = (const direct_bus_header_t*)map;
+    const size_t map_size = (size_t)st.st_size;
+
+    // the geometry is only valid once the publisher opened the bus
+    const bool valid =
+        (__atomic_load_n(&header->state, __ATOMIC_ACQUIRE) != DIRECT_BUS_STATE_INIT) &&
+        (memcmp(header->magic, DIRECT_BUS_MAGIC, sizeof(header->magic)) == 0) &&
+        (header->version == DIRECT_BUS_VERSION) &&
+        (header->num_slots > 0) &&
+        (header->slot_size >= DIRECT_BUS_SLOT_HEADER_SIZE + header->frame_size) &&
+        (header->header_size + (uint64_t)header->num_slots * header->slot_size <= map_size);
+
+    direct_bus_client_t *client = valid ? calloc(1, sizeof(direct_bus_client_t)) : NULL;
+    if(client == NULL) {
+        munmap((void*)map, map_size);
+        return NULL;
+    }
+
+    client->map = map;
+    client->map_size = map_size;
+    client->header = header;
+    client->cursor = __atomic_load_n(&header->head, __ATOMIC_ACQUIRE) + 1;
+    return client;
+}
+
+void direct_bus_client_detach(direct_bus_client_t *client)
+{
+    if(client == NULL)
+        return;
+
+    munmap((void*)client->map, client->map_size);
+    free(client);
+}
+
+/* Blocks until the wake word differs from wake or the deadline passes */
+static void wait_for_wake(const direct_bus_client_t *client, uint32_t wake, uint64_t deadline_us)
+{
+    struct timespec ts;
+    struct timespec *timeout = NULL;
+
+    if(deadline_us != UINT64_MAX) {
+        const uint64_t now_us = monotonic_us();
+        const uint64_t wait_us = (deadline_us > now_us) ? deadline_us - now_us : 0;
+        ts.tv_sec = (time_t)(wait_us / 1000000u);
+        ts.tv_nsec = (long)(wait_us % 1000000u) * 1000;
+        timeout = &ts;
+    }
+
+    syscall(SYS_futex, &client->header->wake, FUTEX_WAIT, wake, timeout, NULL, 0);
+}
+
+direct_bus_status_t direct_bus_client_next(direct_bus_client_t *client,
+    direct_bus_frame_t *frame, int timeout_ms)
+{
+    if(client == NULL)
+        return DIRECT_BUS_ERROR;
+
+    const direct_bus_header_t *header = client->header;
+    const uint64_t deadline_us = (timeout_ms < 0)
+        ? UINT64_MAX
+        : monotonic_us() + (uint64_t)timeout_ms * 1000u;
+
+    for(;;) {
+        // read the wake word first, a frame published after the head is
+        // read changes it and the futex wait returns immediately
+        const uint32_t wake = __atomic_load_n(&header->wake, __ATOMIC_ACQUIRE);
+        const uint64_t head = __atomic_load_n(&header->head, __ATOMIC_ACQUIRE);
+
+        if(head >= client->cursor) {
+            // skip frames the publisher has already overwritten
+            if(head - client->cursor >= header->num_slots) {
+                const uint64_t oldest = head - header->num_slots + 1;
+                client->lost += oldest - client->cursor;
+                client->cursor = oldest;
+            }
+
+            const direct_bus_slot_t *slot = get_slot(client, client->cursor);
+            frame->sequence = client->cursor;
+            frame->frame_number = slot->frame_number;
+            frame->timestamp_us = slot->timestamp_us;
+            frame->d = (const ifx_Float_t*)((const uint8_t*)slot + DIRECT_BUS_SLOT_HEADER_SIZE);
+            frame->num_antennas = header->num_antennas;
+            frame->num_chirps_per_frame = header->num_chirps_per_frame;
+            frame->num_samples_per_chirp = header->num_samples_per_chirp;
+            client->cursor++;
+
+            if(direct_bus_client_still_valid(client, frame))
+                return DIRECT_BUS_OK;
+
+            client->lost++;
+            continue;
+        }
+
+        if(__atomic_load_n(&header->state, __ATOMIC_ACQUIRE) == DIRECT_BUS_STATE_CLOSED)
+            return DIRECT_BUS_CLOSED;
+
+        if(monotonic_us() >= deadline_us)
+            return DIRECT_BUS_TIMEOUT;
+
+        wait_for_wake(client, wake, deadline_us);
+    }
+}
+
+bool direct_bus_client_still_valid(const direct_bus_client_t *client,
+    const direct_bus_frame_t *frame)
+{
+    // order all reads of the frame before the check
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    const direct_bus_slot_t *slot = get_slot(client, frame->sequence);
+    return __atomic_load_n(&slot->sequence, __ATOMIC_RELAXED) == frame->sequence;
+}
+
+direct_bus_status_t direct_bus_client_read(direct_bus_client_t *client,
+    ifx_Float_t *out, direct_bus_frame_t *frame, int timeout_ms)
+{
+    for(;;) {
+        const direct_bus_status_t status = direct_bus_client_next(client, frame, timeout_ms);
+        if(status != DIRECT_BUS_OK)
+            return status;
+
+        memcpy(out, frame->d, client->header->frame_size);
+        if(direct_bus_client_still_valid(client, frame)) {
+            frame->d = out;
+            return DIRECT_BUS_OK;
+        }
+
+        client->lost++;
+    }
+}
+
+uint64_t direct_bus_client_lost_frames(const direct_bus_client_t *client)
+{
+    return (client != NULL) ? client->lost : 0;
+}
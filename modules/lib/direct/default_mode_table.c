@@ -149,13 +149,18 @@ direct_device_default_mode_table[] =
     },
 };
 
+size_t
+direct_device_default_mode_count()
+{
+    return sizeof(direct_device_default_mode_table) / sizeof(direct_device_default_mode_table[0]);
+}
+
 const direct_mode_description_t*
 direct_device_default_mode_find(const char* name)
 {
     const direct_mode_description_t *table =
         direct_device_default_mode_table;
-    const size_t table_size = 
-        sizeof(direct_device_default_mode_table) / sizeof(direct_device_default_mode_table[0]);
+    const size_t table_size = direct_device_default_mode_count();
 
     for (size_t l = 0; l < table_size; l++)
     {
@@ -33,24 +33,86 @@
 
 #include "direct.h"
 #include "SingleReaderSingleWriterRingBuffer.hpp"
+#include "DeinterleaveKernels.hpp"
+#include "FlightRecorder.hpp"
+#include "FrameBus.hpp"
+#include "ifxBase/Mem.h"
 #include <vector>
 #include <atomic>
 #include <thread>
+#include <mutex>
+#include <chrono>
 #include <cstring>
+#include <cmath>
+#include <string>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
 
 static bool data_integrity_test_enabled = false;
 static uint16_t test_mode_shift_register = 0x0001;
+static direct_slicing_config_t slicing_config = { 0, 0, 0 };
+static direct_subset_t subset_config = { 0, 0, 0, 0, 0, 0 };
+static bool packed_storage_enabled = false;
+static struct {
+    bool enabled;
+    uint32_t num_antennas;
+    uint32_t num_samples_per_chirp;
+    std::vector<ifx_Float_t> offset;
+    std::vector<ifx_Float_t> gain;
+} calibration_config = { false, 0, 0, {}, {} };
+static struct {
+    bool enabled;
+    ifx_Window_Config_t config;
+} window_config = { false, { IFX_WINDOW_HANN, 0, 0, 0 } };
+static uint32_t ring_depth = 5;
+static struct {
+    uint32_t num_frames;
+    std::string path_prefix;
+} flight_recorder_config = { 0, "" };
+static FlightRecorder flight_recorder;
+static std::atomic<bool> flight_recorder_running{ false };
+static struct {
+    std::string name;
+    uint32_t num_slots;
+} frame_bus_config = { "", 8 };
+static FrameBus frame_bus;
+static direct_chirp_callback_t chirp_callback = NULL;
+static void *chirp_callback_user = NULL;
+static direct_frame_callback_t frame_callback = NULL;
+static void *frame_callback_user = NULL;
+static int frame_event_fd = -1;
+
+/* A frame in the ring either holds unpacked samples or, with packed storage,
+ * the 12 bit FIFO payload as read from the device (3 bytes per 2 samples) */
+struct raw_frame_t {
+    std::vector<uint16_t> samples;
+    std::vector<uint8_t> packed;
+    uint32_t frame_number;
+    uint64_t timestamp_us;
+};
 
 static struct {
     size_t header_size;
     uint16_t slice_size;
-    uint16_t frame_count;
+    uint32_t frame_count;
     std::thread data_thread;
 
     std::atomic<bool> is_started;
     std::atomic<bool> buffer_overflow;
     std::atomic<bool> fifo_error;
-    SingleReaderSingleWriterRingBuffer<std::vector<uint16_t>> frame_buffer;
+    SingleReaderSingleWriterRingBuffer<raw_frame_t> frame_buffer;
+    raw_frame_t overflow_frame;
+    std::vector<uint16_t> unpacked_frame;
+    bool packed;
+    selection_t selection;
+    deinterleave_kernel_t deinterleave;
+    std::vector<ifx_Float_t> calibration_scale;
+    std::vector<ifx_Float_t> calibration_bias;
+    direct_frame_info_t last_info;
     const direct_mode_description_t* mode;
 } radar;
 
@@ -60,14 +122,281 @@ static bgt60_dev_t bgt60_dev = {
     /* .slice_size = */ 0
 };
 
-static ifx_Cube_R_t* radar_data_frame = NULL;
+/* Pool of output cubes. A cube returned by direct_device_acq_fetch() is
+ * released implicitly on the next fetch, cubes returned by
+ * direct_device_acq_fetch_hold() stay valid until they are released. */
+static struct {
+    std::mutex lock;
+    uint32_t num_slots;
+    std::vector<ifx_Cube_R_t*> cubes;
+    std::vector<bool> held;
+    ifx_Cube_R_t* implicit;
+} output = { {}, 1, {}, {}, NULL };
 
 static bool get_next_frame_from_buffer(uint16_t* buffer, ifx_Cube_R_t* frame);
+static bool radar_fetch_frame(ifx_Cube_R_t* frame);
+static uint64_t get_timestamp_us();
+static bool resolve_selection(const direct_mode_description_t *mode, selection_t *selection);
+static bool prepare_calibration(const direct_mode_description_t *mode, const selection_t *selection);
+static bool create_output_slots();
+static void destroy_output_slots();
+static ifx_Cube_R_t* acquire_output_slot();
+static bool release_output_slot(ifx_Cube_R_t* frame);
+static bool resolve_selection(const direct_mode_description_t *mode, selection_t *selection)
+{
+    const direct_subset_t& subset = subset_config;
+    const uint32_t num_chirps = mode->seg_config.num_chirps_per_frame;
+    const uint32_t num_samples = mode->seg_config.num_samples_per_chirp;
+
+    selection->num_rx = 0;
+    for(uint32_t rx = 0; rx < mode->num_antennas && rx < 32; rx++)
+    {
+        if((subset.antenna_mask == 0) || (subset.antenna_mask & (1u << rx)))
+            selection->rx[selection->num_rx++] = (uint8_t)rx;
+    }
+
+    if((selection->num_rx == 0) ||
+       ((mode->num_antennas < 32) && (subset.antenna_mask >> mode->num_antennas) != 0))
+    {
+        rep_err("antenna selection 0x%x doesn't match the %u antennas of the mode.\n",
+            (unsigned)subset.antenna_mask, (unsigned)mode->num_antennas);
+        return false;
+    }
+
+    selection->chirp_start = subset.chirp_start;
+    selection->chirp_stride = (subset.chirp_stride > 0) ? subset.chirp_stride : 1;
+    selection->sample_start = subset.sample_start;
+
+    if((subset.chirp_start >= num_chirps) || (subset.sample_start >= num_samples))
+    {
+        rep_err("chirp or sample selection starts outside of the frame.\n");
+        return false;
+    }
+
+    const uint32_t max_chirps =
+        (num_chirps - subset.chirp_start + selection->chirp_stride - 1) / selection->chirp_stride;
+    const uint32_t max_samples = num_samples - subset.sample_start;
+
+    selection->num_chirps = (subset.chirp_count > 0) ? subset.chirp_count : max_chirps;
+    selection->num_samples = (subset.sample_count > 0) ? subset.sample_count : max_samples;
+
+    if((selection->num_chirps > max_chirps) || (selection->num_samples > max_samples))
+    {
+        rep_err("chirp or sample selection exceeds the frame.\n");
+        return false;
+    }
+
+    return true;
+}
+
+/* Fold ADC normalization, offset, gain and window into one scale and bias per
+ * output row (selected sample * number of selected antennas + selected antenna) */
+static bool prepare_calibration(const direct_mode_description_t *mode, const selection_t *selection)
+{
+    radar.calibration_scale.clear();
+    radar.calibration_bias.clear();
+
+    if(!calibration_config.enabled && !window_config.enabled)
+        return true;
+
+    const uint32_t num_samples = mode->seg_config.num_samples_per_chirp;
+    const uint32_t values_per_antenna = calibration_config.num_samples_per_chirp;
+
+    if(calibration_config.enabled &&
+       ((calibration_config.num_antennas != mode->num_antennas) ||
+        ((values_per_antenna != 0) && (values_per_antenna != num_samples))))
+    {
+        rep_err("calibration for %u antennas and %u samples doesn't match the mode.\n",
+            (unsigned)calibration_config.num_antennas, (unsigned)values_per_antenna);
+        return false;
+    }
+
+    const ifx_Vector_R_t *window = NULL;
+    if(window_config.enabled)
+    {
+        ifx_Window_Config_t config = window_config.config;
+        config.size = selection->num_samples;
+
+        window = ifx_window_get(&config);
+        if(window == NULL)
+        {
+            rep_err("failed to compute the window for %u samples.\n", (unsigned)config.size);
+            return false;
+        }
+    }
+
+    const size_t num_rows = (size_t)selection->num_rx * selection->num_samples;
+    radar.calibration_scale.resize(num_rows);
+    radar.calibration_bias.resize(num_rows);
+
+    for(uint32_t s = 0; s < selection->num_samples; s++)
+    {
+        for(uint32_t r = 0; r < selection->num_rx; r++)
+        {
+            const size_t rx = selection->rx[r];
+            const size_t index = (values_per_antenna != 0)
+                ? rx * values_per_antenna + selection->sample_start + s
+                : rx;
+            const ifx_Float_t offset = calibration_config.offset.empty() ? 0 : calibration_config.offset[index];
+            const ifx_Float_t gain = (calibration_config.gain.empty() ? 1 : calibration_config.gain[index]) *
+                ((window != NULL) ? IFX_VEC_AT(window, s) : 1);
+            const size_t row = (size_t)s * selection->num_rx + r;
+
+            radar.calibration_scale[row] = gain / 4095;
+            radar.calibration_bias[row] = -offset * gain;
+        }
+    }
+
+    return true;
+}
+
+static bool create_output_slots()
+{
+    // slots left behind by a start which failed later on are replaced
+    destroy_output_slots();
+
+    bool ok = true;
+    {
+        std::lock_guard<std::mutex> guard(output.lock);
+
+        for(uint32_t slot = 0; ok && (slot < output.num_slots); slot++)
+        {
+            ifx_Cube_R_t* cube = ifx_cube_create_r(
+                radar.selection.num_rx,
+                radar.selection.num_chirps,
+                radar.selection.num_samples);
+
+            ok = (cube != NULL);
+            if(ok)
+            {
+                output.cubes.push_back(cube);
+                output.held.push_back(false);
+            }
+        }
+    }
+
+    if(!ok)
+        destroy_output_slots();
+
+    return ok;
+}
+
+static void destroy_output_slots()
+{
+    std::lock_guard<std::mutex> guard(output.lock);
+
+    for(auto cube : output.cubes)
+        ifx_cube_destroy_r(cube);
+
+    output.cubes.clear();
+    output.held.clear();
+    output.implicit = NULL;
+}
+
+static ifx_Cube_R_t* acquire_output_slot()
+{
+    std::lock_guard<std::mutex> guard(output.lock);
+
+    for(size_t slot = 0; slot < output.cubes.size(); slot++)
+    {
+        if(!output.held[slot])
+        {
+            output.held[slot] = true;
+            return output.cubes[slot];
+        }
+    }
+
+    return NULL;
+}
+
+static bool release_output_slot(ifx_Cube_R_t* frame)
+{
+    std::lock_guard<std::mutex> guard(output.lock);
+
+    for(size_t slot = 0; slot < output.cubes.size(); slot++)
+    {
+        if(output.cubes[slot] == frame)
+        {
+            output.held[slot] = false;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void check_default_mode_kernels();
+static void signal_frame_event();
+static void wait_frame_event();
+static void clear_frame_events();
 static void unpack_raw12(uint8_t* src, uint32_t count, uint16_t* dst);
 static uint32_t get_num_samples_per_frame();
 static uint32_t get_num_slices_per_frame();
 static uint32_t get_num_samples_per_slice();
 static uint32_t get_spi_transfer_size();
+static uint16_t select_slice_size(uint32_t words_per_frame);
+
+static uint64_t get_timestamp_us()
+{
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<microseconds>(
+        steady_clock::now().time_since_epoch()).count();
+}
+
+static void check_default_mode_kernels()
+{
+    // deinterleave_dims is maintained by hand, a default mode missing from
+    // it would silently fall back to the generic kernel
+    for(size_t m = 0; m < direct_device_default_mode_count(); m++)
+    {
+        const direct_mode_description_t& mode = direct_device_default_mode_table[m];
+
+        if(deinterleave_find_fixed(mode.num_antennas, mode.seg_config.num_chirps_per_frame,
+               mode.seg_config.num_samples_per_chirp, false) == nullptr)
+        {
+            rep_err("default mode '%s' has no specialized deinterleave kernel, update deinterleave_dims.\n",
+                mode.specifier);
+        }
+    }
+}
+
+static void signal_frame_event()
+{
+#ifdef __linux__
+    if(frame_event_fd >= 0)
+        eventfd_write(frame_event_fd, 1);
+#endif
+}
+
+static void wait_frame_event()
+{
+#ifdef __linux__
+    if(frame_event_fd >= 0)
+    {
+        // events are signalled after the frame has been committed, so taking
+        // one before popping keeps the counter from running ahead of the ring
+        eventfd_t value;
+        struct pollfd pfd = { frame_event_fd, POLLIN, 0 };
+        while(eventfd_read(frame_event_fd, &value) != 0)
+            poll(&pfd, 1, -1);
+        return;
+    }
+#endif
+    radar.frame_buffer.wait_fill(1);
+}
+
+static void clear_frame_events()
+{
+#ifdef __linux__
+    eventfd_t value;
+    if(frame_event_fd >= 0)
+    {
+        // the counter is in semaphore mode, each read takes one event
+        while(eventfd_read(frame_event_fd, &value) == 0)
+            ;
+    }
+#endif
+}
 
 static void test_mode_lsfr_init()
 {
@@ -111,6 +440,100 @@ static uint32_t get_spi_transfer_size()
     return radar.slice_size * 3 + radar.header_size;
 }
 
+static uint16_t select_slice_size(uint32_t words_per_frame)
+{
+    // never let a slice take more than half of the FIFO, so the next slice
+    // can be acquired while the current one is transferred
+    const uint32_t max_slice_size = BGT60_FIFO_SIZE / 2;
+    const double frame_rate = slicing_config.frame_rate_Hz;
+
+    uint32_t min_slices = (words_per_frame + max_slice_size - 1) / max_slice_size;
+    uint32_t max_slices = words_per_frame;
+
+    // the latency of a slice is estimated as the frame period divided by the
+    // number of slices, i.e. assuming samples are produced evenly over the frame
+    if(slicing_config.max_latency_s > 0)
+    {
+        const double n = std::ceil(1.0 / (frame_rate * slicing_config.max_latency_s));
+        if(n > min_slices)
+            min_slices = (n < words_per_frame) ? (uint32_t)n : words_per_frame;
+    }
+
+    if(slicing_config.max_interrupt_rate_Hz > 0)
+    {
+        const double n = std::floor(slicing_config.max_interrupt_rate_Hz / frame_rate);
+        if(n < max_slices)
+            max_slices = (n > 1) ? (uint32_t)n : 1;
+    }
+
+    // only slice counts which divide the frame evenly keep slice and frame
+    // boundaries aligned
+    uint32_t num_slices = 0;
+    if(slicing_config.max_latency_s > 0)
+    {
+        // fewest interrupts that still meet the latency budget
+        for(uint32_t n = min_slices; n <= words_per_frame && num_slices == 0; n++)
+        {
+            if(words_per_frame % n == 0)
+                num_slices = n;
+        }
+        if(num_slices > max_slices)
+            rep_err("FIFO latency budget requires %u interrupts per frame, exceeding the interrupt rate limit\n",
+                (unsigned)num_slices);
+    }
+    else
+    {
+        // lowest latency within the interrupt rate budget
+        for(uint32_t n = max_slices; n >= min_slices && num_slices == 0; n--)
+        {
+            if(words_per_frame % n == 0)
+                num_slices = n;
+        }
+        if(num_slices == 0)
+        {
+            for(uint32_t n = min_slices; n <= words_per_frame && num_slices == 0; n++)
+            {
+                if(words_per_frame % n == 0)
+                    num_slices = n;
+            }
+            rep_err("FIFO interrupt rate limit can't be met, using %u interrupts per frame\n",
+                (unsigned)num_slices);
+        }
+    }
+
+    return (uint16_t)(words_per_frame / num_slices);
+}
+
+static void deliver_chirps(const uint16_t* frame, uint32_t first, uint32_t end)
+{
+    const uint32_t num_samples_per_chirp = radar.mode->seg_config.num_samples_per_chirp;
+    const uint32_t chirp_size = radar.mode->num_antennas * num_samples_per_chirp;
+
+    direct_chirp_view_t view;
+    view.frame_number = radar.frame_count;
+    view.num_chirps_per_frame = radar.mode->seg_config.num_chirps_per_frame;
+    view.num_samples_per_chirp = num_samples_per_chirp;
+    view.num_antennas = radar.mode->num_antennas;
+
+    for(uint32_t chirp = first; chirp < end; chirp++)
+    {
+        view.data = frame + chirp * chirp_size;
+        view.chirp_index = chirp;
+        chirp_callback(&view, chirp_callback_user);
+    }
+}
+
+static void capture_frame(const raw_frame_t* frame, uint32_t flags)
+{
+    if(!flight_recorder.is_active())
+        return;
+
+    const void* data = radar.packed
+        ? (const void*)frame->packed.data()
+        : (const void*)frame->samples.data();
+    flight_recorder.capture(data, frame->frame_number, frame->timestamp_us, flags);
+}
+
 static void read_frame_data(void)
 {
     static uint32_t slice_cnt = 0;
@@ -118,8 +541,17 @@ static void read_frame_data(void)
     static uint32_t cnt= 0;
 
     std::vector<uint8_t> slice_data(get_spi_transfer_size());
-    std::vector<uint16_t> frame_buffer(get_num_samples_per_frame());
     const uint32_t num_slices_per_frame = get_num_slices_per_frame();
+    const uint32_t samples_per_slice = get_num_samples_per_slice();
+    const uint32_t chirp_size =
+        radar.mode->num_antennas * radar.mode->seg_config.num_samples_per_chirp;
+    uint32_t chirps_delivered = 0;
+
+    // assemble the frame directly in the ring buffer, if the ring is full
+    // use a spare frame and try again once the frame is complete
+    raw_frame_t* frame_buffer = radar.frame_buffer.peek_push();
+    if(frame_buffer == nullptr)
+        frame_buffer = &radar.overflow_frame;
 
     for(size_t slice = 0; slice < num_slices_per_frame; slice++) 
     {
@@ -127,7 +559,7 @@ static void read_frame_data(void)
         {
             if (bgt60_get_fifo_data(&bgt60_dev, slice_data.data()) == 0)
             {
-                slice_data.data()[1] = slice_cnt & (num_slices_per_frame - 1);
+                slice_data.data()[1] = slice_cnt % num_slices_per_frame;
                 *(uint16_t *)&slice_data.data()[2] = (slice_cnt / num_slices_per_frame) & 0xFFFF;
                 buffer_idx++;
                 slice_cnt++;
@@ -138,18 +570,61 @@ static void read_frame_data(void)
                 radar.fifo_error = true;
             }
         }
-        unpack_raw12(
-            slice_data.data() + radar.header_size,
-            get_spi_transfer_size() - radar.header_size,
-            frame_buffer.data() + slice * get_num_samples_per_slice());
+        const uint32_t payload_size = get_spi_transfer_size() - radar.header_size;
+        if(radar.packed)
+        {
+            // unpacking is deferred to the consumer
+            memcpy(frame_buffer->packed.data() + slice * payload_size,
+                slice_data.data() + radar.header_size,
+                payload_size);
+        }
+        else
+        {
+            unpack_raw12(
+                slice_data.data() + radar.header_size,
+                payload_size,
+                frame_buffer->samples.data() + slice * samples_per_slice);
+        }
+
+        if(chirp_callback != NULL)
+        {
+            const uint32_t chirps_available = ((slice + 1) * samples_per_slice) / chirp_size;
+            deliver_chirps(frame_buffer->samples.data(), chirps_delivered, chirps_available);
+            chirps_delivered = chirps_available;
+        }
     }
 
-    if(!radar.frame_buffer.try_push(frame_buffer))
+    frame_buffer->frame_number = radar.frame_count;
+    frame_buffer->timestamp_us = get_timestamp_us();
+
+    // the consumer may modify a queued frame (the data integrity test clears
+    // it), so a frame in the ring is recorded before it is committed. The
+    // overflow frame stays with this thread, try_push queues a copy.
+    bool queued = true;
+    if(frame_buffer != &radar.overflow_frame)
+    {
+        capture_frame(frame_buffer, 0);
+        radar.frame_buffer.commit_push();
+        signal_frame_event();
+    }
+    else if(radar.frame_buffer.try_push(radar.overflow_frame))
+    {
+        signal_frame_event();
+        capture_frame(frame_buffer, 0);
+    }
+    else
     {
         rep_err("Frame buffer overflow (size: %d fill: %d)\n",
             radar.frame_buffer.size(), radar.frame_buffer.fill());
         radar.buffer_overflow = true;
+        queued = false;
+        capture_frame(frame_buffer, DIRECT_FLIGHT_FRAME_NOT_QUEUED);
     }
+
+    if(queued && (frame_callback != NULL))
+        frame_callback(radar.frame_count, frame_callback_user);
+
+    radar.frame_count++;
 }
 
 static void spi_data_thread()
@@ -163,19 +638,28 @@ static void spi_data_thread()
 
 static bool radar_fetch_frame(ifx_Cube_R_t* frame)
 {
-    const uint32_t samples_per_frame = get_num_samples_per_frame();
-    std::vector<uint16_t> frame_buffer(samples_per_frame);
-    if(radar.is_started)
-    {
-        radar.frame_buffer.wait_fill(1);
-        radar.frame_buffer.try_pop(frame_buffer);
-    }
-    else
+    if(!radar.is_started)
     {
         rep_err("trying to fetch data when the acquisition hasn't been started.\n");
         return false;
     }
 
+    // convert straight out of the ring buffer and only free the entry
+    // once the conversion is done
+    wait_frame_event();
+    raw_frame_t* raw = radar.frame_buffer.peek();
+    const uint32_t samples_per_frame = get_num_samples_per_frame();
+    bool ok = true;
+
+    if(radar.packed)
+    {
+        unpack_raw12(raw->packed.data(),
+            (uint32_t)raw->packed.size(),
+            radar.unpacked_frame.data());
+    }
+    std::vector<uint16_t>& frame_buffer =
+        radar.packed ? radar.unpacked_frame : raw->samples;
+
     if(data_integrity_test_enabled) {
         for(size_t i = 0; 
             i < samples_per_frame; 
@@ -191,7 +675,8 @@ static bool radar_fetch_frame(ifx_Cube_R_t* frame)
                     (int)expected,
                     (int)frame_buffer[i]
                 );
-                return false;
+                ok = false;
+                break;
             }
         }
 
@@ -201,7 +686,18 @@ static bool radar_fetch_frame(ifx_Cube_R_t* frame)
         std::fill(frame_buffer.begin(), frame_buffer.end(), 0);
     }
 
-    return get_next_frame_from_buffer(frame_buffer.data(), frame);
+    if(ok)
+        ok = get_next_frame_from_buffer(frame_buffer.data(), frame);
+
+    radar.last_info.frame_number = raw->frame_number;
+    radar.last_info.timestamp_us = raw->timestamp_us;
+
+    if(ok && frame_bus.is_active())
+        frame_bus.publish(IFX_CUBE_DAT(frame), raw->frame_number, raw->timestamp_us);
+
+    radar.frame_buffer.try_pop();
+
+    return ok;
 }
 
 static void unpack_raw12(uint8_t* src, uint32_t count, uint16_t* dst)
@@ -215,39 +711,184 @@ static void unpack_raw12(uint8_t* src, uint32_t count, uint16_t* dst)
 
 static bool get_next_frame_from_buffer(uint16_t* buffer, ifx_Cube_R_t* frame)
 {
-    const uint32_t num_chirps_per_frame = IFX_CUBE_COLS(frame);
-    const uint32_t num_samples_per_chirp = IFX_CUBE_SLICES(frame);
-    const uint8_t num_rx = IFX_CUBE_ROWS(frame);
-    const ifx_Float_t adc_max = 4095; 
+    // the buffer holds all acquired data, only the selected subset is converted
+    radar.deinterleave(buffer, radar.selection, radar.mode->num_antennas,
+        radar.mode->seg_config.num_samples_per_chirp,
+        radar.calibration_scale.data(), radar.calibration_bias.data(), IFX_CUBE_DAT(frame));
 
-    for(size_t rx = 0; rx < num_rx; rx++)
-    {
-        for (size_t chirp = 0; chirp < num_chirps_per_frame; chirp++)
-        {
-            const size_t chirp_offset = chirp * num_rx * num_samples_per_chirp;
+    return true;
+}
 
-            for (size_t sample = 0; sample < num_samples_per_chirp; sample++)
-            {
-                // sample0_RX1 sample0_RX2, sample1_RX1, sample2_RX2, ...
-                const size_t sample_offset = sample * num_rx;
-                const size_t index = rx + sample_offset + chirp_offset;
-                IFX_CUBE_AT(frame, rx, chirp, sample) =
-                    buffer[index] / adc_max;
-            }
-        }
+
+void direct_device_configure_data_integrity_test(bool enable)
+{
+    data_integrity_test_enabled = enable;
+}
+
+void direct_device_configure_slicing(const direct_slicing_config_t *config)
+{
+    if(config != NULL)
+        slicing_config = *config;
+    else
+        slicing_config = direct_slicing_config_t{ 0, 0, 0 };
+}
+
+bool direct_device_configure_subset(const direct_subset_t *subset)
+{
+    if(radar.is_started) {
+        rep_err("data subset can't be changed while the acquisition is running.\n");
+        return false;
     }
 
+    if(subset != NULL)
+        subset_config = *subset;
+    else
+        subset_config = direct_subset_t{ 0, 0, 0, 0, 0, 0 };
+
     return true;
 }
 
+bool direct_device_configure_calibration(const direct_calibration_t *calibration)
+{
+    if(radar.is_started) {
+        rep_err("calibration can't be changed while the acquisition is running.\n");
+        return false;
+    }
 
-void direct_device_configure_data_integrity_test(bool enable)
+    calibration_config.offset.clear();
+    calibration_config.gain.clear();
+    calibration_config.enabled = false;
+
+    if(calibration == NULL)
+        return true;
+
+    if(calibration->num_antennas == 0) {
+        rep_err("calibration needs to cover at least one antenna.\n");
+        return false;
+    }
+
+    const size_t count = (size_t)calibration->num_antennas *
+        ((calibration->num_samples_per_chirp != 0) ? calibration->num_samples_per_chirp : 1);
+
+    if(calibration->offset != NULL)
+        calibration_config.offset.assign(calibration->offset, calibration->offset + count);
+    if(calibration->gain != NULL)
+        calibration_config.gain.assign(calibration->gain, calibration->gain + count);
+
+    calibration_config.num_antennas = calibration->num_antennas;
+    calibration_config.num_samples_per_chirp = calibration->num_samples_per_chirp;
+    calibration_config.enabled = true;
+    return true;
+}
+
+bool direct_device_configure_window(const ifx_Window_Config_t *window)
 {
-    data_integrity_test_enabled = enable;
+    if(radar.is_started) {
+        rep_err("window can't be changed while the acquisition is running.\n");
+        return false;
+    }
+
+    window_config.enabled = (window != NULL);
+    if(window != NULL)
+        window_config.config = *window;
+
+    return true;
+}
+
+bool direct_device_configure_flight_recorder(const direct_flight_recorder_config_t *config)
+{
+    if(radar.is_started) {
+        rep_err("flight recorder can't be changed while the acquisition is running.\n");
+        return false;
+    }
+
+    flight_recorder_config.num_frames = (config != NULL) ? config->num_frames : 0;
+    flight_recorder_config.path_prefix =
+        ((config != NULL) && (config->path_prefix != NULL)) ? config->path_prefix : "flight";
+    return true;
+}
+
+bool direct_device_configure_bus(const direct_bus_config_t *config)
+{
+    if(radar.is_started) {
+        rep_err("frame bus can't be changed while the acquisition is running.\n");
+        return false;
+    }
+
+    frame_bus_config.name = ((config != NULL) && (config->name != NULL)) ? config->name : "";
+    frame_bus_config.num_slots = ((config != NULL) && (config->num_slots > 0)) ? config->num_slots : 8;
+    return true;
+}
+
+bool direct_device_flight_recorder_trigger()
+{
+    if(!flight_recorder_running)
+        return false;
+
+    flight_recorder.trigger();
+    return true;
+}
+
+void direct_device_configure_packed_storage(bool enable)
+{
+    if(radar.is_started) {
+        rep_err("frame storage can't be changed while the acquisition is running.\n");
+        return;
+    }
+
+    packed_storage_enabled = enable;
+}
+
+void direct_device_configure_ring_depth(uint32_t num_frames)
+{
+    if(radar.is_started) {
+        rep_err("ring depth can't be changed while the acquisition is running.\n");
+        return;
+    }
+
+    ring_depth = (num_frames > 0) ? num_frames : 1;
+}
+
+void direct_device_set_chirp_callback(direct_chirp_callback_t callback, void *user)
+{
+    if(radar.is_started) {
+        rep_err("chirp callback can't be changed while the acquisition is running.\n");
+        return;
+    }
+
+    chirp_callback = callback;
+    chirp_callback_user = user;
+}
+
+void direct_device_set_frame_callback(direct_frame_callback_t callback, void *user)
+{
+    if(radar.is_started) {
+        rep_err("frame callback can't be changed while the acquisition is running.\n");
+        return;
+    }
+
+    frame_callback = callback;
+    frame_callback_user = user;
+}
+
+int direct_device_get_event_fd()
+{
+    return frame_event_fd;
 }
 
 void direct_device_init()
 {
+    check_default_mode_kernels();
+
+#ifdef __linux__
+    if(frame_event_fd < 0)
+    {
+        frame_event_fd = eventfd(0, EFD_NONBLOCK | EFD_SEMAPHORE | EFD_CLOEXEC);
+        if(frame_event_fd < 0)
+            rep_err("failed to create frame event fd.\n");
+    }
+#endif
+
     radar.frame_count = 0;
     radar.is_started = false;
     radar.buffer_overflow = false;
@@ -258,6 +899,14 @@ void direct_device_init()
 void direct_device_deinit()
 {
     direct_device_stop();
+
+#ifdef __linux__
+    if(frame_event_fd >= 0)
+    {
+        close(frame_event_fd);
+        frame_event_fd = -1;
+    }
+#endif
 }
 
 static bool setup_bgt(const direct_mode_description_t *mode)
@@ -265,10 +914,37 @@ static bool setup_bgt(const direct_mode_description_t *mode)
     if(bgt60_init(&bgt60_dev, mode->regs) != 0)
         return false;
 
-    radar.slice_size = bgt60_dev.slice_size;
     radar.frame_count = 0;
     radar.mode = mode;
 
+    // one FIFO word holds two 12 bit samples
+    const uint32_t words_per_frame = get_num_samples_per_frame() / 2;
+
+    const bool auto_slicing =
+        (slicing_config.max_interrupt_rate_Hz > 0) ||
+        (slicing_config.max_latency_s > 0);
+
+    if(auto_slicing)
+    {
+        if(slicing_config.frame_rate_Hz <= 0)
+        {
+            rep_err("frame rate is required to derive the FIFO slice size.\n");
+            return false;
+        }
+
+        if(bgt60_set_slice_size(&bgt60_dev, select_slice_size(words_per_frame)) != 0)
+            return false;
+    }
+
+    radar.slice_size = bgt60_dev.slice_size;
+
+    if((radar.slice_size == 0) || (words_per_frame % radar.slice_size != 0))
+    {
+        rep_err("slice size of %u FIFO words doesn't divide a frame of %u words.\n",
+            (unsigned)radar.slice_size, (unsigned)words_per_frame);
+        return false;
+    }
+
     rep_msg("Assuming %u slices per frame\n", (unsigned)get_num_slices_per_frame());
 
     return true;
@@ -284,12 +960,17 @@ bool direct_device_start(const direct_mode_description_t *mode)
     // get antenna count from configuration
     const uint8_t rx_antenna_count = mode->num_antennas;
 
-    radar_data_frame = ifx_cube_create_r(
-        rx_antenna_count,
-        mode->seg_config.num_chirps_per_frame,
-        mode->seg_config.num_samples_per_chirp);
+    if(!resolve_selection(mode, &radar.selection))
+        return false;
+
+    if(!prepare_calibration(mode, &radar.selection))
+        return false;
 
-    if(radar_data_frame == NULL) {
+    radar.deinterleave = deinterleave_select_kernel(radar.selection, mode->num_antennas,
+        mode->seg_config.num_chirps_per_frame, mode->seg_config.num_samples_per_chirp,
+        !radar.calibration_scale.empty());
+
+    if(!create_output_slots()) {
         rep_err("Failed to initialize internal data structure for recording\n");
         return false;
     }
@@ -313,12 +994,54 @@ bool direct_device_start(const direct_mode_description_t *mode)
         return false;
     }
 
-    radar.frame_buffer.resize(5, [=](std::vector<uint16_t>& f)
+    // chirps are handed out unpacked while the frame is acquired, so there
+    // is nothing to gain from packed storage when streaming chirps
+    radar.packed = packed_storage_enabled && (chirp_callback == NULL);
+    if(packed_storage_enabled && !radar.packed)
+        rep_msg("chirp callback registered, storing frames unpacked.\n");
+
+    const size_t samples_per_frame = (size_t)rx_antenna_count *
+        mode->seg_config.num_chirps_per_frame *
+        mode->seg_config.num_samples_per_chirp;
+    const size_t unpacked_size = radar.packed ? 0 : samples_per_frame;
+    const size_t packed_size = radar.packed ? (samples_per_frame * 3) / 2 : 0;
+
+    radar.frame_buffer.resize(ring_depth, [=](raw_frame_t& f)
     {
-        f.resize(rx_antenna_count*
-            mode->seg_config.num_chirps_per_frame*
-            mode->seg_config.num_samples_per_chirp);
+        f.samples.resize(unpacked_size);
+        f.samples.shrink_to_fit();
+        f.packed.resize(packed_size);
+        f.packed.shrink_to_fit();
     });
+    radar.overflow_frame.samples.resize(unpacked_size);
+    radar.overflow_frame.packed.resize(packed_size);
+    radar.unpacked_frame.resize(radar.packed ? samples_per_frame : 0);
+
+    if(flight_recorder_config.num_frames > 0)
+    {
+        direct_flight_record_header_t header;
+        memcpy(header.magic, DIRECT_FLIGHT_RECORD_MAGIC, sizeof(header.magic));
+        header.num_antennas = rx_antenna_count;
+        header.num_chirps_per_frame = mode->seg_config.num_chirps_per_frame;
+        header.num_samples_per_chirp = mode->seg_config.num_samples_per_chirp;
+        header.packed = radar.packed ? 1 : 0;
+        header.frame_size = (uint32_t)(radar.packed ? packed_size : unpacked_size * sizeof(uint16_t));
+        header.num_frames = flight_recorder_config.num_frames;
+        header.reserved = 0;
+
+        if(!flight_recorder.create(header, flight_recorder_config.path_prefix.c_str())) {
+            rep_err("failed to set up the flight recorder.\n");
+            return false;
+        }
+        flight_recorder_running = true;
+    }
+
+    if(!frame_bus_config.name.empty() &&
+       !frame_bus.create(frame_bus_config.name.c_str(), frame_bus_config.num_slots,
+            radar.selection.num_rx, radar.selection.num_chirps, radar.selection.num_samples)) {
+        rep_err("failed to set up the frame bus.\n");
+        return false;
+    }
 
     if(bgt60_frame_start(&bgt60_dev, true) != 0) {
         rep_err("failed to initialize BGT60 driver.\n");
@@ -341,10 +1064,14 @@ void direct_device_stop()
         radar.data_thread.join(); 
         radar.frame_buffer.reset();
         radar.frame_count = 0;
+        clear_frame_events();
     }
 
-    ifx_cube_destroy_r(radar_data_frame);
-    radar_data_frame = NULL;
+    flight_recorder_running = false;
+    flight_recorder.destroy();
+    frame_bus.destroy();
+
+    destroy_output_slots();
 
     bgt60_platform_deinit();
 }
@@ -353,9 +1080,149 @@ bool direct_device_acq_fetch(ifx_Cube_R_t **out)
 {
     *out = NULL; // already indicate no more data in case anything fails
 
-    if(!radar_fetch_frame(radar_data_frame))
+    if(output.implicit != NULL)
+    {
+        release_output_slot(output.implicit);
+        output.implicit = NULL;
+    }
+
+    if(!direct_device_acq_fetch_hold(out))
+        return false;
+
+    output.implicit = *out;
+    return true;
+}
+
+bool direct_device_acq_fetch_hold(ifx_Cube_R_t **out)
+{
+    *out = NULL; // already indicate no more data in case anything fails
+
+    ifx_Cube_R_t* frame = acquire_output_slot();
+    if(frame == NULL)
+    {
+        rep_err("all %u output slots are held, release a frame before fetching the next one.\n",
+            (unsigned)output.num_slots);
+        return false;
+    }
+
+    if(!radar_fetch_frame(frame))
+    {
+        release_output_slot(frame);
+        return false;
+    }
+
+    *out = frame;
+    return true;
+}
+
+void direct_device_acq_release(ifx_Cube_R_t *frame)
+{
+    if(frame == NULL)
+        return;
+
+    if(!release_output_slot(frame))
+        rep_err("released frame doesn't belong to the output pool.\n");
+}
+
+void direct_device_configure_output_slots(uint32_t num_slots)
+{
+    if(radar.is_started) {
+        rep_err("output slots can't be changed while the acquisition is running.\n");
+        return;
+    }
+
+    output.num_slots = (num_slots > 0) ? num_slots : 1;
+}
+
+bool direct_device_acq_last_frame_info(direct_frame_info_t *info)
+{
+    if(info == NULL)
+        return false;
+
+    *info = radar.last_info;
+    return true;
+}
+
+direct_frame_batch_t* direct_device_batch_create(
+    const direct_mode_description_t *mode,
+    uint32_t capacity)
+{
+    selection_t selection;
+    if((mode == NULL) || (capacity == 0) || !resolve_selection(mode, &selection))
+        return NULL;
+
+    direct_frame_batch_t* batch =
+        (direct_frame_batch_t*)ifx_mem_calloc(1, sizeof(direct_frame_batch_t));
+    if(batch == NULL)
+        return NULL;
+
+    batch->capacity = capacity;
+    batch->num_antennas = selection.num_rx;
+    batch->num_chirps_per_frame = selection.num_chirps;
+    batch->num_samples_per_chirp = selection.num_samples;
+
+    const size_t frame_size = (size_t)batch->num_antennas *
+        batch->num_chirps_per_frame * batch->num_samples_per_chirp;
+
+    batch->d = (ifx_Float_t*)ifx_mem_aligned_alloc(
+        ALIGN(frame_size * capacity * sizeof(ifx_Float_t)), MEMORY_ALIGNMENT);
+    batch->info = (direct_frame_info_t*)ifx_mem_calloc(capacity, sizeof(direct_frame_info_t));
+
+    if((batch->d == NULL) || (batch->info == NULL))
+    {
+        direct_device_batch_destroy(batch);
+        return NULL;
+    }
+
+    return batch;
+}
+
+void direct_device_batch_destroy(direct_frame_batch_t *batch)
+{
+    if(batch == NULL)
+        return;
+
+    ifx_mem_aligned_free(batch->d);
+    ifx_mem_free(batch->info);
+    ifx_mem_free(batch);
+}
+
+bool direct_device_acq_fetch_batch(uint32_t num_frames, direct_frame_batch_t *batch)
+{
+    if((batch == NULL) || (num_frames > batch->capacity))
+    {
+        rep_err("batch can't hold %u frames.\n", (unsigned)num_frames);
         return false;
+    }
+
+    if(!radar.is_started ||
+       (batch->num_antennas != radar.selection.num_rx) ||
+       (batch->num_chirps_per_frame != radar.selection.num_chirps) ||
+       (batch->num_samples_per_chirp != radar.selection.num_samples))
+    {
+        rep_err("batch doesn't match the running acquisition.\n");
+        return false;
+    }
+
+    const size_t frame_size = (size_t)batch->num_antennas *
+        batch->num_chirps_per_frame * batch->num_samples_per_chirp;
+
+    batch->num_frames = 0;
+    for(uint32_t f = 0; f < num_frames; f++)
+    {
+        // non-owning view on the f-th frame of the tensor
+        ifx_Cube_R_t frame;
+        ifx_cube_init_r(&frame, batch->d + f * frame_size,
+            batch->num_antennas,
+            batch->num_chirps_per_frame,
+            batch->num_samples_per_chirp);
+
+        if(!radar_fetch_frame(&frame))
+            return false;
+
+        batch->info[f] = radar.last_info;
+        batch->num_frames++;
+    }
 
-    *out = radar_data_frame;
     return true;
 }
@@ -148,6 +148,37 @@ int32_t bgt60_init(bgt60_dev_t *const dev, const uint32_t *const regs)
     return status;
 }
 
+int32_t bgt60_set_slice_size(bgt60_dev_t *const dev, uint16_t slice_size)
+{
+    uint32_t tmp;
+    int32_t status;
+
+    if ((dev == NULL) || (slice_size == 0) ||
+        (slice_size > ((BGT60_REG_SFCTL_FIFO_CREF_MSK >> BGT60_REG_SFCTL_FIFO_CREF_POS) + 1)))
+    {
+        return BGT60_STATUS_PARAM_ERROR;
+    }
+
+    status = bgt60_get_reg(dev, BGT60_REG_SFCTL, &tmp);
+    if (status != 0)
+    {
+        return status;
+    }
+
+    // the interrupt is raised once CREF + 1 FIFO words are available
+    tmp &= (uint32_t)~BGT60_REG_SFCTL_FIFO_CREF_MSK;
+    tmp |= ((uint32_t)(slice_size - 1) << BGT60_REG_SFCTL_FIFO_CREF_POS) & BGT60_REG_SFCTL_FIFO_CREF_MSK;
+
+    status = bgt60_set_reg(dev, BGT60_REG_SFCTL, tmp);
+    if (status == 0)
+    {
+        dev->slice_size = slice_size;
+        rep_msg("slice size %d \n", dev->slice_size);
+    }
+
+    return status;
+}
+
 int32_t bgt60_set_reg(bgt60_dev_t *const dev, uint32_t reg_addr, uint32_t data)
 {
     int32_t status;
@@ -70,6 +70,7 @@ extern "C" {
 #endif
 
 int32_t bgt60_init(bgt60_dev_t *const dev, const uint32_t *const regs);
+int32_t bgt60_set_slice_size(bgt60_dev_t *const dev, uint16_t slice_size);
 int32_t bgt60_set_reg(bgt60_dev_t *const dev, uint32_t reg_addr, uint32_t data);
 int32_t bgt60_get_reg(bgt60_dev_t *const dev, uint32_t reg_addr, uint32_t *const data);
 int32_t bgt60_get_fifo_data(bgt60_dev_t *const dev, uint8_t *const data);
@@ -44,8 +44,10 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "ifxBase/Cube.h"
+#include "ifxBase/Window.h"
 
 typedef enum {
     IFX_ORIENTATION_LANDSCAPE = 0U, /**< Sensor is oriented in landscape format (default) */
@@ -71,13 +73,189 @@ typedef struct {
     ifx_Config_t seg_config;
 } direct_mode_description_t;
 
+/* Constraints used to pick the FIFO slice size (the number of FIFO words
+ * after which the BGT60 raises its data interrupt). Bigger slices mean fewer
+ * interrupts and SPI transfers, smaller slices mean less time between a
+ * sample being measured and it being handed to the consumer.
+ *
+ * If neither max_interrupt_rate_Hz nor max_latency_s is set, the slice size
+ * programmed by the mode's register list is used unchanged. */
+typedef struct {
+    ifx_Float_t frame_rate_Hz;          /**< Frame rate configured by the mode's register list. */
+    ifx_Float_t max_interrupt_rate_Hz;  /**< Upper limit for FIFO interrupts per second, 0 for no limit. */
+    ifx_Float_t max_latency_s;          /**< Upper limit for the time to fill one slice, 0 for no limit. */
+} direct_slicing_config_t;
+
+/* Meta data of an acquired frame */
+typedef struct {
+    uint32_t frame_number;          /**< Sequence number since the acquisition was started */
+    uint64_t timestamp_us;          /**< Time the frame was completed, monotonic clock in us */
+} direct_frame_info_t;
+
+/* K consecutive frames in one contiguous, aligned tensor of dimensions
+ * frames x antennas x chirps x samples. Frame f is a cube starting at
+ * d + f * num_antennas * num_chirps_per_frame * num_samples_per_chirp with
+ * the same layout as the cubes returned by direct_device_acq_fetch(). */
+typedef struct {
+    ifx_Float_t *d;                 /**< Frame data */
+    direct_frame_info_t *info;      /**< Meta data of each frame */
+    uint32_t capacity;              /**< Maximum number of frames */
+    uint32_t num_frames;            /**< Number of valid frames */
+    uint32_t num_antennas;
+    uint32_t num_chirps_per_frame;
+    uint32_t num_samples_per_chirp;
+} direct_frame_batch_t;
+
+/* Part of the acquired data which ends up in the output cubes. Skipped data
+ * is never converted. The cube dimensions become (number of selected
+ * antennas) x chirp_count x sample_count. */
+typedef struct {
+    uint32_t antenna_mask;      /**< Bit n selects RX antenna n, 0 selects all antennas */
+    uint32_t chirp_start;       /**< First selected chirp */
+    uint32_t chirp_count;       /**< Number of selected chirps, 0 for as many as fit */
+    uint32_t chirp_stride;      /**< Distance between selected chirps, 0 or 1 for consecutive chirps */
+    uint32_t sample_start;      /**< First selected sample of each chirp */
+    uint32_t sample_count;      /**< Number of selected samples, 0 for all remaining */
+} direct_subset_t;
+
+/* Calibration applied while converting the ADC values, the output value is
+ * (adc / 4095 - offset) * gain. Values are given per antenna of the mode, or,
+ * if num_samples_per_chirp is set, per antenna and sample with the antenna
+ * as outer index. The tables are copied by direct_device_configure_calibration(). */
+typedef struct {
+    uint32_t num_antennas;          /**< Number of antennas the tables cover, must match the mode */
+    uint32_t num_samples_per_chirp; /**< 0 for one value per antenna, else must match the mode */
+    const ifx_Float_t *offset;      /**< DC offsets in normalized units, NULL for none */
+    const ifx_Float_t *gain;        /**< Gain factors, NULL for unity gain */
+} direct_calibration_t;
+
+/* Flight recorder, keeps the last num_frames raw frames in memory and writes
+ * them to <path_prefix>-<frame number>.bin when triggered */
+typedef struct {
+    uint32_t num_frames;            /**< Number of frames kept, 0 disables the recorder */
+    const char *path_prefix;        /**< Path and name prefix of the dump files */
+} direct_flight_recorder_config_t;
+
+#define DIRECT_FLIGHT_RECORD_MAGIC "DFR1"
+
+/* Set if the frame couldn't be queued for the consumer and was dropped */
+#define DIRECT_FLIGHT_FRAME_NOT_QUEUED (1u << 0)
+
+/* A flight recorder dump is this header followed by num_frames times a
+ * direct_flight_record_frame_t and frame_size bytes of frame data. The data
+ * is either num_antennas * num_chirps_per_frame * num_samples_per_chirp
+ * uint16_t ADC values in FIFO order or, if packed is set, the 12 bit FIFO
+ * payload with two samples in three bytes. All values are host endian. */
+typedef struct {
+    char magic[4];                  /**< DIRECT_FLIGHT_RECORD_MAGIC */
+    uint32_t num_antennas;
+    uint32_t num_chirps_per_frame;
+    uint32_t num_samples_per_chirp;
+    uint32_t packed;                /**< 1 if the frames are stored in the 12 bit wire format */
+    uint32_t frame_size;            /**< Bytes of data per frame */
+    uint32_t num_frames;            /**< Number of frames in the file */
+    uint32_t reserved;
+} direct_flight_record_header_t;
+
+typedef struct {
+    uint32_t frame_number;
+    uint32_t flags;                 /**< DIRECT_FLIGHT_FRAME_* */
+    uint64_t timestamp_us;          /**< Time the frame was completed, monotonic clock in us */
+} direct_flight_record_frame_t;
+
+/* Shared memory frame bus, see direct_bus.h. Every fetched frame is
+ * published for other processes. */
+typedef struct {
+    const char *name;               /**< Name of the POSIX shared memory object, e.g. "/radar", NULL disables the bus */
+    uint32_t num_slots;             /**< Number of frames in the ring, 0 for the default of 8 */
+} direct_bus_config_t;
+
+/* View of one chirp of the frame which is currently being acquired. The
+ * samples are the raw 12 bit ADC values in FIFO order, i.e. interleaved per
+ * antenna: sample0_RX1, sample0_RX2, sample1_RX1, sample1_RX2, ...
+ * The view points into the frame buffer and is only valid for the duration
+ * of the callback. */
+typedef struct {
+    const uint16_t *data;           /**< num_samples_per_chirp * num_antennas raw samples */
+    uint32_t frame_number;          /**< Number of the frame the chirp belongs to */
+    uint32_t chirp_index;           /**< Index of the chirp within the frame */
+    uint32_t num_chirps_per_frame;  /**< Number of chirps in the frame */
+    uint32_t num_samples_per_chirp; /**< Number of samples per chirp and antenna */
+    uint8_t num_antennas;           /**< Number of interleaved antennas */
+} direct_chirp_view_t;
+
+/* Called from the acquisition thread as soon as a chirp has been unpacked,
+ * before the rest of the frame is available. Keep it short, time spent in
+ * the callback delays reading the FIFO. */
+typedef void (*direct_chirp_callback_t)(const direct_chirp_view_t *chirp, void *user);
+
+/* Called from the acquisition thread each time a complete frame has been
+ * queued and can be fetched with direct_device_acq_fetch(). */
+typedef void (*direct_frame_callback_t)(uint32_t frame_number, void *user);
+
 extern void direct_device_init();
 extern void direct_device_deinit();
 extern void direct_device_configure_data_integrity_test(bool enable);
+extern void direct_device_configure_slicing(const direct_slicing_config_t *config);
+/* Select the data subset to convert, NULL selects all data */
+extern bool direct_device_configure_subset(const direct_subset_t *subset);
+/* Calibrate the converted data, NULL disables the calibration */
+extern bool direct_device_configure_calibration(const direct_calibration_t *calibration);
+/* Window the samples of each chirp while converting the data. The window is
+ * folded into the conversion tables, so it costs no extra pass over the
+ * frame. The size of the config is ignored, the window spans the selected
+ * samples. NULL disables the window. */
+extern bool direct_device_configure_window(const ifx_Window_Config_t *window);
+/* Keep frames in the ring in the packed 12 bit wire format and unpack them
+ * when they are fetched. This moves the unpacking from the acquisition
+ * thread to the consumer and shrinks the ring by a quarter. */
+extern void direct_device_configure_packed_storage(bool enable);
+/* Number of frames the ring between acquisition thread and consumer can
+ * hold (default 5) */
+extern void direct_device_configure_ring_depth(uint32_t num_frames);
+/* Number of output cubes in the pool (default 1). Each frame held with
+ * direct_device_acq_fetch_hold() occupies one slot until it is released. */
+extern void direct_device_configure_output_slots(uint32_t num_slots);
+/* Enable the flight recorder for the next acquisition, NULL disables it */
+extern bool direct_device_configure_flight_recorder(const direct_flight_recorder_config_t *config);
+/* Dump the frames currently held by the flight recorder. Safe to call from
+ * signal handlers. Returns false if the recorder isn't running. */
+extern bool direct_device_flight_recorder_trigger();
+/* Publish the frames of the next acquisition on a frame bus, NULL disables it */
+extern bool direct_device_configure_bus(const direct_bus_config_t *config);
+extern void direct_device_set_chirp_callback(direct_chirp_callback_t callback, void *user);
+extern void direct_device_set_frame_callback(direct_frame_callback_t callback, void *user);
+/* Returns a file descriptor which is readable as long as frames are queued,
+ * so the acquisition can be driven from poll/epoll based event loops. Each
+ * direct_device_acq_fetch() waits for and consumes one event before taking
+ * its frame, so the descriptor and the queue never get out of step.
+ * Returns -1 if the platform doesn't support it. The descriptor is owned by the library and stays valid
+ * until direct_device_deinit(). */
+extern int direct_device_get_event_fd();
 extern bool direct_device_start(const direct_mode_description_t *mode);
 extern void direct_device_stop();
 extern bool direct_device_acq_fetch(
     ifx_Cube_R_t **out);
+/* Fetch a frame which stays valid across further fetches until it is given
+ * back with direct_device_acq_release(). Fails if all slots are held. */
+extern bool direct_device_acq_fetch_hold(
+    ifx_Cube_R_t **out);
+extern void direct_device_acq_release(
+    ifx_Cube_R_t *frame);
+/* Meta data of the frame returned by the last fetch */
+extern bool direct_device_acq_last_frame_info(
+    direct_frame_info_t *info);
+
+extern direct_frame_batch_t* direct_device_batch_create(
+    const direct_mode_description_t *mode,
+    uint32_t capacity);
+extern void direct_device_batch_destroy(
+    direct_frame_batch_t *batch);
+/* Fetch num_frames consecutive frames into batch, blocks until all of them
+ * have been acquired. */
+extern bool direct_device_acq_fetch_batch(
+    uint32_t num_frames,
+    direct_frame_batch_t *batch);
 
 
 /* Default mode table which might be re-used in another application.
@@ -90,6 +268,10 @@ extern direct_mode_description_t direct_device_default_mode_table[];
 extern const direct_mode_description_t*
 direct_device_default_mode_find(const char* name);
 
+/* Number of entries in direct_device_default_mode_table
+ */
+extern size_t direct_device_default_mode_count();
+
 
 #ifdef __cplusplus
 } // extern "C"
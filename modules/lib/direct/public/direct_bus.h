@@ -0,0 +1,152 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file direct_bus.h
+ *
+ * @brief Shared memory frame bus
+ *
+ * The acquisition process publishes every fetched frame into a ring of
+ * slots in a POSIX shared memory object, any number of other processes can
+ * attach read-only and consume the frames in place.
+ *
+ * The object starts with a direct_bus_header_t, followed by num_slots slots
+ * of slot_size bytes starting at header_size. A slot is a direct_bus_slot_t
+ * followed by the frame data at DIRECT_BUS_SLOT_HEADER_SIZE, a cube with the
+ * layout returned by direct_device_acq_fetch().
+ *
+ * Frames are numbered by a sequence starting at 1, frame n is written to
+ * slot (n - 1) % num_slots. The publisher never waits for consumers: while a
+ * slot is rewritten its sequence is 0, so a consumer detects that a frame
+ * was overwritten while reading it by comparing the slot sequence before and
+ * after. Each consumer keeps its own read cursor. The wake word is
+ * incremented with every frame and consumers block on it with a futex.
+ */
+
+#ifndef DIRECT_BUS_H
+#define DIRECT_BUS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ifxBase/Types.h"
+
+#define DIRECT_BUS_MAGIC "DFB1"
+#define DIRECT_BUS_VERSION 1u
+#define DIRECT_BUS_SLOT_HEADER_SIZE 64u
+
+typedef enum {
+    DIRECT_BUS_STATE_INIT = 0u,     /**< Publisher is still setting up the ring */
+    DIRECT_BUS_STATE_OPEN = 1u,     /**< Frames are being published */
+    DIRECT_BUS_STATE_CLOSED = 2u,   /**< Publisher stopped, no more frames will follow */
+} direct_bus_state_t;
+
+typedef struct {
+    char magic[4];                  /**< DIRECT_BUS_MAGIC */
+    uint32_t version;               /**< DIRECT_BUS_VERSION */
+    uint32_t header_size;           /**< Offset of the first slot */
+    uint32_t slot_size;             /**< Distance between two slots */
+    uint32_t num_slots;
+    uint32_t num_antennas;
+    uint32_t num_chirps_per_frame;
+    uint32_t num_samples_per_chirp;
+    uint32_t frame_size;            /**< Bytes of frame data in each slot */
+    uint32_t state;                 /**< direct_bus_state_t */
+    uint32_t wake;                  /**< Futex word, changes with every published frame */
+    uint32_t publisher_pid;
+    uint64_t head;                  /**< Sequence of the latest published frame, 0 for none */
+} direct_bus_header_t;
+
+typedef struct {
+    uint64_t sequence;              /**< Sequence of the frame in the slot, 0 while it is written */
+    uint32_t frame_number;          /**< Frame number of the acquisition */
+    uint32_t reserved;
+    uint64_t timestamp_us;          /**< Time the frame was completed, monotonic clock in us */
+} direct_bus_slot_t;
+
+/*
+==============================================================================
+   client
+==============================================================================
+*/
+
+typedef enum {
+    DIRECT_BUS_OK = 0,
+    DIRECT_BUS_TIMEOUT = 1,         /**< No frame within the timeout */
+    DIRECT_BUS_CLOSED = 2,          /**< The publisher stopped, attach again for a new run */
+    DIRECT_BUS_ERROR = 3,
+} direct_bus_status_t;
+
+typedef struct direct_bus_client direct_bus_client_t;
+
+/* A frame in the shared memory ring. d points into the ring and is
+ * overwritten by the publisher num_slots frames later, check with
+ * direct_bus_client_still_valid() after using it. */
+typedef struct {
+    const ifx_Float_t *d;
+    uint64_t sequence;
+    uint32_t frame_number;
+    uint64_t timestamp_us;
+    uint32_t num_antennas;
+    uint32_t num_chirps_per_frame;
+    uint32_t num_samples_per_chirp;
+} direct_bus_frame_t;
+
+/* Attach read-only to the bus with the given shared memory name. The first
+ * frame received is the first one published after attaching. Returns NULL
+ * if the bus doesn't exist or isn't set up yet. */
+extern direct_bus_client_t* direct_bus_client_attach(const char *name);
+extern void direct_bus_client_detach(direct_bus_client_t *client);
+
+/* Wait up to timeout_ms (negative for no limit) for the next frame and
+ * return a view of it in the ring */
+extern direct_bus_status_t direct_bus_client_next(direct_bus_client_t *client,
+    direct_bus_frame_t *frame, int timeout_ms);
+
+/* Returns false if the publisher has started to overwrite the frame */
+extern bool direct_bus_client_still_valid(const direct_bus_client_t *client,
+    const direct_bus_frame_t *frame);
+
+/* Like direct_bus_client_next(), but copies the frame to out, which holds
+ * num_antennas * num_chirps_per_frame * num_samples_per_chirp values. A frame
+ * overwritten while copying is skipped. frame->d is set to out. */
+extern direct_bus_status_t direct_bus_client_read(direct_bus_client_t *client,
+    ifx_Float_t *out, direct_bus_frame_t *frame, int timeout_ms);
+
+/* Number of frames the client missed because the publisher overtook it */
+extern uint64_t direct_bus_client_lost_frames(const direct_bus_client_t *client);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DIRECT_BUS_H */
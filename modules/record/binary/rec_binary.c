@@ -0,0 +1,693 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+// O_DIRECT and fallocate
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "rec_binary.h"
+#include "rec_codec.h"
+#include "interface/record_format.h"
+#include "interface/report.h"
+#include "ifxBase/Mem.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define REC_BLOCK_SIZE      4096u           /* alignment required by O_DIRECT */
+#define REC_BUFFER_SIZE     (1024u * 1024u) /* multiple of REC_BLOCK_SIZE */
+#define REC_NUM_BUFFERS     4u
+#define REC_MAX_CODEC_THREADS 8u
+#define REC_JOBS_PER_THREAD 2u
+#define REC_MAX_JOBS        (REC_MAX_CODEC_THREADS * REC_JOBS_PER_THREAD)
+
+typedef enum {
+    REC_BUFFER_FREE,
+    REC_BUFFER_FULL,
+} rec_buffer_state_t;
+
+/* A frame on its way through the encoder threads. Jobs are filled and
+ * committed to the file in order, but encoded in any order. */
+typedef enum {
+    REC_JOB_FREE,
+    REC_JOB_QUEUED,
+    REC_JOB_BUSY,
+    REC_JOB_DONE,
+} rec_job_state_t;
+
+typedef struct {
+    rec_job_state_t state;
+    rec_codec_dims_t dims;
+    uint32_t frame_index;
+    uint64_t timestamp_us;
+    uint16_t *q;
+    size_t q_capacity;
+    uint8_t *out;
+    size_t out_capacity;
+    size_t out_size;
+} rec_job_t;
+
+typedef struct {
+    uint8_t *data;
+    size_t used;
+    uint32_t file_index;
+    bool close_file;        /* last buffer of the file */
+    rec_buffer_state_t state;
+} rec_buffer_t;
+
+static struct {
+    char path[1024];
+    rec_binary_config_t config;
+
+    pthread_t writer;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    bool running;
+    bool quit;
+    bool failed;
+
+    rec_buffer_t buffers[REC_NUM_BUFFERS];
+    uint32_t fill;          /* buffer the caller is filling */
+    uint32_t drain;         /* next buffer for the writer */
+
+    /* caller side state of the current file */
+    uint32_t file_index;
+    uint64_t file_bytes;
+    uint64_t file_start_us;
+    uint32_t frame_index;
+    rec_file_header_t header;
+
+    /* encoder threads, only used with compression */
+    pthread_t encoders[REC_MAX_CODEC_THREADS];
+    uint32_t num_encoders;
+    pthread_mutex_t job_lock;
+    pthread_cond_t job_changed;
+    bool jobs_quit;
+    rec_job_t jobs[REC_MAX_JOBS];
+    uint32_t num_jobs;
+    uint32_t job_fill;      /* next job to fill */
+    uint32_t job_commit;    /* next job to write to the file */
+} s_bin;
+
+static bool start_encoders();
+static void stop_encoders();
+static bool commit_jobs(bool wait);
+
+static uint64_t now_us()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static bool rotation_enabled()
+{
+    return (s_bin.config.rotate_bytes > 0) || (s_bin.config.rotate_s > 0);
+}
+
+static void file_path(uint32_t index, char *out, size_t size)
+{
+    if(!rotation_enabled()) {
+        snprintf(out, size, "%s", s_bin.path);
+        return;
+    }
+
+    // insert the index in front of the extension
+    const char *slash = strrchr(s_bin.path, '/');
+    const char *dot = strrchr(s_bin.path, '.');
+    if((dot == NULL) || ((slash != NULL) && (dot < slash)))
+        dot = s_bin.path + strlen(s_bin.path);
+
+    snprintf(out, size, "%.*s-%04u%s", (int)(dot - s_bin.path), s_bin.path, (unsigned)index, dot);
+}
+
+/*
+==============================================================================
+   writer thread
+==============================================================================
+*/
+
+static int open_file(uint32_t index)
+{
+    char path[1100];
+    file_path(index, path, sizeof(path));
+
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_CLOEXEC
+    flags |= O_CLOEXEC;
+#endif
+
+    int fd = -1;
+#ifdef O_DIRECT
+    if(s_bin.config.direct_io) {
+        fd = open(path, flags | O_DIRECT, 0644);
+        if((fd < 0) && (errno == EINVAL))
+            rep_msg("'%s' doesn't support direct I/O, writing through the page cache.\n", path);
+    }
+#endif
+    if(fd < 0)
+        fd = open(path, flags, 0644);
+
+    if(fd < 0) {
+        rep_err("Could not open file '%s' to record incoming data: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+#ifdef __linux__
+    const uint64_t reserve = (s_bin.config.rotate_bytes > 0)
+        ? s_bin.config.rotate_bytes
+        : s_bin.config.preallocate_bytes;
+
+    // reserve contiguous space up front, the file is trimmed when closed
+    if((reserve > 0) && (fallocate(fd, 0, 0, (off_t)reserve) != 0))
+        rep_msg("preallocating '%s' failed: %s\n", path, strerror(errno));
+#endif
+
+    return fd;
+}
+
+static bool write_buffer(int fd, const rec_buffer_t *buffer, uint64_t offset)
+{
+    // only the last buffer of a file is partially filled, it is padded to
+    // the block size and the padding is truncated when the file is closed
+    const size_t length = (buffer->used + REC_BLOCK_SIZE - 1) & ~(size_t)(REC_BLOCK_SIZE - 1);
+    size_t done = 0;
+
+    while(done < length) {
+        const ssize_t n = pwrite(fd, buffer->data + done, length - done, (off_t)(offset + done));
+        if(n < 0) {
+            if(errno == EINTR)
+                continue;
+            rep_err("Recording data to file failed: %s\n", strerror(errno));
+            return false;
+        }
+        done += (size_t)n;
+    }
+
+    return true;
+}
+
+static void *writer_thread(void *arg)
+{
+    (void)arg;
+    int fd = -1;
+    uint32_t open_index = 0;
+    uint64_t offset = 0;
+    bool failed = false;
+
+    pthread_mutex_lock(&s_bin.lock);
+
+    for(;;) {
+        rec_buffer_t *buffer = &s_bin.buffers[s_bin.drain];
+
+        while((buffer->state != REC_BUFFER_FULL) && !s_bin.quit)
+            pthread_cond_wait(&s_bin.changed, &s_bin.lock);
+
+        if(buffer->state != REC_BUFFER_FULL)
+            break;
+
+        pthread_mutex_unlock(&s_bin.lock);
+
+        if(!failed && ((fd < 0) || (open_index != buffer->file_index))) {
+            if(fd >= 0)
+                close(fd);
+            fd = open_file(buffer->file_index);
+            open_index = buffer->file_index;
+            offset = 0;
+            failed = (fd < 0);
+        }
+
+        if(!failed && (buffer->used > 0)) {
+            failed = !write_buffer(fd, buffer, offset);
+            offset += buffer->used;
+        }
+
+        if(!failed && buffer->close_file) {
+            if(ftruncate(fd, (off_t)offset) != 0) {
+                rep_err("Truncating the recording failed: %s\n", strerror(errno));
+                failed = true;
+            }
+            close(fd);
+            fd = -1;
+        }
+
+        pthread_mutex_lock(&s_bin.lock);
+
+        s_bin.failed = s_bin.failed || failed;
+        buffer->used = 0;
+        buffer->close_file = false;
+        buffer->state = REC_BUFFER_FREE;
+        s_bin.drain = (s_bin.drain + 1) % REC_NUM_BUFFERS;
+        pthread_cond_broadcast(&s_bin.changed);
+    }
+
+    pthread_mutex_unlock(&s_bin.lock);
+
+    if(fd >= 0)
+        close(fd);
+
+    return NULL;
+}
+
+/*
+==============================================================================
+   caller side
+==============================================================================
+*/
+
+/* Hands the current buffer to the writer and waits for the next one */
+static bool submit_buffer(bool close_file)
+{
+    pthread_mutex_lock(&s_bin.lock);
+
+    rec_buffer_t *buffer = &s_bin.buffers[s_bin.fill];
+    buffer->file_index = s_bin.file_index;
+    buffer->close_file = close_file;
+    buffer->state = REC_BUFFER_FULL;
+    pthread_cond_broadcast(&s_bin.changed);
+
+    s_bin.fill = (s_bin.fill + 1) % REC_NUM_BUFFERS;
+    while((s_bin.buffers[s_bin.fill].state != REC_BUFFER_FREE) && !s_bin.failed)
+        pthread_cond_wait(&s_bin.changed, &s_bin.lock);
+
+    const bool ok = !s_bin.failed;
+    pthread_mutex_unlock(&s_bin.lock);
+
+    return ok;
+}
+
+static bool append(const void *data, size_t size)
+{
+    const uint8_t *src = data;
+
+    while(size > 0) {
+        rec_buffer_t *buffer = &s_bin.buffers[s_bin.fill];
+        const size_t n = (size < REC_BUFFER_SIZE - buffer->used) ? size : REC_BUFFER_SIZE - buffer->used;
+
+        memcpy(buffer->data + buffer->used, src, n);
+        buffer->used += n;
+        src += n;
+        size -= n;
+
+        if((buffer->used == REC_BUFFER_SIZE) && !submit_buffer(false))
+            return false;
+    }
+
+    s_bin.file_bytes += (uint64_t)(src - (const uint8_t *)data);
+    return true;
+}
+
+static bool begin_file(const rec_codec_dims_t *dims)
+{
+    static uint8_t padded[REC_FORMAT_HEADER_SIZE];
+
+    s_bin.file_bytes = 0;
+    s_bin.file_start_us = now_us();
+
+    rec_file_header_t *header = &s_bin.header;
+    memcpy(header->magic, REC_FORMAT_MAGIC, sizeof(header->magic));
+    header->version = REC_FORMAT_VERSION;
+    header->header_size = REC_FORMAT_HEADER_SIZE;
+    header->sample_format = (s_bin.config.compression > 0) ? REC_SAMPLE_CODED : REC_SAMPLE_FLOAT32;
+    header->num_antennas = dims->num_antennas;
+    header->num_chirps_per_frame = dims->num_chirps_per_frame;
+    header->num_samples_per_chirp = dims->num_samples_per_chirp;
+    header->file_index = s_bin.file_index;
+    header->start_time_us = s_bin.file_start_us;
+
+    memset(padded, 0, sizeof(padded));
+    memcpy(padded, header, sizeof(*header));
+
+    return append(padded, sizeof(padded));
+}
+
+static bool end_file()
+{
+    // an empty buffer still closes the file
+    return submit_buffer(true);
+}
+
+static bool needs_new_file(const rec_codec_dims_t *dims, size_t record_size)
+{
+    const rec_file_header_t *header = &s_bin.header;
+
+    if((header->num_antennas != dims->num_antennas) ||
+       (header->num_chirps_per_frame != dims->num_chirps_per_frame) ||
+       (header->num_samples_per_chirp != dims->num_samples_per_chirp))
+        return true;
+
+    // every file holds at least one frame
+    if(s_bin.file_bytes <= REC_FORMAT_HEADER_SIZE)
+        return false;
+
+    if((s_bin.config.rotate_bytes > 0) &&
+       (s_bin.file_bytes + record_size > s_bin.config.rotate_bytes))
+        return true;
+
+    return (s_bin.config.rotate_s > 0) &&
+           (now_us() - s_bin.file_start_us >= (uint64_t)s_bin.config.rotate_s * 1000000u);
+}
+
+bool rec_binary_start(const char *path, const rec_binary_config_t *config)
+{
+    rec_binary_stop();
+
+    snprintf(s_bin.path, sizeof(s_bin.path), "%s", path);
+    s_bin.config = *config;
+
+    for(uint32_t i = 0; i < REC_NUM_BUFFERS; i++) {
+        rec_buffer_t *buffer = &s_bin.buffers[i];
+        buffer->data = ifx_mem_aligned_alloc(REC_BUFFER_SIZE, REC_BLOCK_SIZE);
+        buffer->used = 0;
+        buffer->close_file = false;
+        buffer->state = REC_BUFFER_FREE;
+
+        if(buffer->data == NULL) {
+            rep_err("failed to allocate recording buffers.\n");
+            for(uint32_t j = 0; j < i; j++)
+                ifx_mem_aligned_free(s_bin.buffers[j].data);
+            return false;
+        }
+    }
+
+    s_bin.fill = 0;
+    s_bin.drain = 0;
+    s_bin.quit = false;
+    s_bin.failed = false;
+    s_bin.file_index = 0;
+    s_bin.file_bytes = 0;
+    s_bin.frame_index = 0;
+    memset(&s_bin.header, 0, sizeof(s_bin.header));
+
+    pthread_mutex_init(&s_bin.lock, NULL);
+    pthread_cond_init(&s_bin.changed, NULL);
+
+    if(pthread_create(&s_bin.writer, NULL, writer_thread, NULL) != 0) {
+        rep_err("failed to start the recording thread.\n");
+        pthread_cond_destroy(&s_bin.changed);
+        pthread_mutex_destroy(&s_bin.lock);
+        for(uint32_t i = 0; i < REC_NUM_BUFFERS; i++)
+            ifx_mem_aligned_free(s_bin.buffers[i].data);
+        return false;
+    }
+
+    s_bin.running = true;
+
+    if((s_bin.config.compression > 0) && !start_encoders()) {
+        rec_binary_stop();
+        return false;
+    }
+
+    return true;
+}
+
+bool rec_binary_stop()
+{
+    if(!s_bin.running)
+        return true;
+
+    if(s_bin.config.compression > 0) {
+        // write out everything which is still being encoded
+        bool ok = true;
+        while(ok && (s_bin.job_commit != s_bin.job_fill || s_bin.jobs[s_bin.job_commit].state != REC_JOB_FREE))
+            ok = commit_jobs(true);
+        stop_encoders();
+    }
+
+    if(s_bin.file_bytes > 0)
+        end_file();
+
+    pthread_mutex_lock(&s_bin.lock);
+    s_bin.quit = true;
+    pthread_cond_broadcast(&s_bin.changed);
+    pthread_mutex_unlock(&s_bin.lock);
+
+    pthread_join(s_bin.writer, NULL);
+
+    pthread_cond_destroy(&s_bin.changed);
+    pthread_mutex_destroy(&s_bin.lock);
+    for(uint32_t i = 0; i < REC_NUM_BUFFERS; i++) {
+        ifx_mem_aligned_free(s_bin.buffers[i].data);
+        s_bin.buffers[i].data = NULL;
+    }
+
+    s_bin.running = false;
+    return !s_bin.failed;
+}
+
+/* Appends a frame to the current file, starting a new file if needed */
+static bool commit_frame(const rec_codec_dims_t *dims, uint32_t frame_index, uint64_t timestamp_us,
+    const void *data, size_t data_size)
+{
+    const rec_frame_header_t frame_header = { (uint32_t)data_size, frame_index, timestamp_us };
+
+    if(s_bin.file_bytes == 0) {
+        if(!begin_file(dims))
+            return false;
+    }
+    else if(needs_new_file(dims, sizeof(frame_header) + data_size)) {
+        // without rotation the next file would have the same name and
+        // truncate the recording written so far
+        if(!rotation_enabled()) {
+            rep_err("Frame dimensions changed, '%s' can only hold one size without file rotation.\n",
+                s_bin.path);
+            return false;
+        }
+        if(!end_file())
+            return false;
+        s_bin.file_index++;
+        if(!begin_file(dims))
+            return false;
+    }
+
+    return append(&frame_header, sizeof(frame_header)) &&
+           append(data, data_size);
+}
+
+/*
+==============================================================================
+   encoder threads
+==============================================================================
+*/
+
+static void *encoder_thread(void *arg)
+{
+    (void)arg;
+    const rec_codec_t codec = (rec_codec_t)s_bin.config.compression;
+
+    pthread_mutex_lock(&s_bin.job_lock);
+
+    for(;;) {
+        rec_job_t *job = NULL;
+        for(uint32_t i = 0; (i < s_bin.num_jobs) && (job == NULL); i++) {
+            if(s_bin.jobs[i].state == REC_JOB_QUEUED)
+                job = &s_bin.jobs[i];
+        }
+
+        if(job == NULL) {
+            if(s_bin.jobs_quit)
+                break;
+            pthread_cond_wait(&s_bin.job_changed, &s_bin.job_lock);
+            continue;
+        }
+
+        job->state = REC_JOB_BUSY;
+        pthread_mutex_unlock(&s_bin.job_lock);
+
+        job->out_size = rec_codec_encode(&job->dims, codec, job->q, job->out);
+
+        pthread_mutex_lock(&s_bin.job_lock);
+        job->state = REC_JOB_DONE;
+        pthread_cond_broadcast(&s_bin.job_changed);
+    }
+
+    pthread_mutex_unlock(&s_bin.job_lock);
+    return NULL;
+}
+
+/* Writes encoded frames to the file in order. With wait set, blocks until
+ * the oldest job is done, otherwise stops at the first job in flight. */
+static bool commit_jobs(bool wait)
+{
+    bool ok = true;
+
+    pthread_mutex_lock(&s_bin.job_lock);
+
+    for(;;) {
+        rec_job_t *job = &s_bin.jobs[s_bin.job_commit];
+
+        while(wait && ((job->state == REC_JOB_QUEUED) || (job->state == REC_JOB_BUSY)))
+            pthread_cond_wait(&s_bin.job_changed, &s_bin.job_lock);
+
+        if(job->state != REC_JOB_DONE)
+            break;
+
+        pthread_mutex_unlock(&s_bin.job_lock);
+        ok = ok && commit_frame(&job->dims, job->frame_index, job->timestamp_us, job->out, job->out_size);
+        pthread_mutex_lock(&s_bin.job_lock);
+
+        job->state = REC_JOB_FREE;
+        s_bin.job_commit = (s_bin.job_commit + 1) % s_bin.num_jobs;
+        wait = false;
+    }
+
+    pthread_mutex_unlock(&s_bin.job_lock);
+    return ok;
+}
+
+static bool job_reserve(rec_job_t *job, const rec_codec_dims_t *dims)
+{
+    const size_t count = (size_t)dims->num_antennas * dims->num_chirps_per_frame * dims->num_samples_per_chirp;
+    const size_t out_size = rec_codec_max_size(dims);
+
+    if(job->q_capacity < count) {
+        free(job->q);
+        job->q = malloc(count * sizeof(uint16_t));
+        job->q_capacity = (job->q != NULL) ? count : 0;
+    }
+    if(job->out_capacity < out_size) {
+        free(job->out);
+        job->out = malloc(out_size);
+        job->out_capacity = (job->out != NULL) ? out_size : 0;
+    }
+
+    return (job->q != NULL) && (job->out != NULL);
+}
+
+static bool start_encoders()
+{
+    uint32_t threads = s_bin.config.codec_threads;
+    if(threads == 0)
+        threads = 1;
+    if(threads > REC_MAX_CODEC_THREADS)
+        threads = REC_MAX_CODEC_THREADS;
+
+    s_bin.num_jobs = threads * REC_JOBS_PER_THREAD;
+    s_bin.job_fill = 0;
+    s_bin.job_commit = 0;
+    s_bin.jobs_quit = false;
+    memset(s_bin.jobs, 0, sizeof(s_bin.jobs));
+
+    pthread_mutex_init(&s_bin.job_lock, NULL);
+    pthread_cond_init(&s_bin.job_changed, NULL);
+
+    for(s_bin.num_encoders = 0; s_bin.num_encoders < threads; s_bin.num_encoders++) {
+        if(pthread_create(&s_bin.encoders[s_bin.num_encoders], NULL, encoder_thread, NULL) != 0) {
+            rep_err("failed to start the encoder threads.\n");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void stop_encoders()
+{
+    pthread_mutex_lock(&s_bin.job_lock);
+    s_bin.jobs_quit = true;
+    pthread_cond_broadcast(&s_bin.job_changed);
+    pthread_mutex_unlock(&s_bin.job_lock);
+
+    for(uint32_t i = 0; i < s_bin.num_encoders; i++)
+        pthread_join(s_bin.encoders[i], NULL);
+    s_bin.num_encoders = 0;
+
+    pthread_cond_destroy(&s_bin.job_changed);
+    pthread_mutex_destroy(&s_bin.job_lock);
+
+    for(uint32_t i = 0; i < REC_MAX_JOBS; i++) {
+        free(s_bin.jobs[i].q);
+        free(s_bin.jobs[i].out);
+    }
+    memset(s_bin.jobs, 0, sizeof(s_bin.jobs));
+}
+
+static bool write_frame_coded(const rec_codec_dims_t *dims, uint32_t frame_index,
+    uint64_t timestamp_us, const ifx_Cube_R_t *frame)
+{
+    rec_job_t *job = &s_bin.jobs[s_bin.job_fill];
+
+    // the job is free once it has been written, otherwise it is the oldest
+    // one and the encoders are behind
+    pthread_mutex_lock(&s_bin.job_lock);
+    const bool busy = (job->state != REC_JOB_FREE);
+    pthread_mutex_unlock(&s_bin.job_lock);
+
+    if(busy && !commit_jobs(true))
+        return false;
+
+    if(!job_reserve(job, dims)) {
+        rep_err("failed to allocate encoder buffers.\n");
+        return false;
+    }
+
+    job->dims = *dims;
+    job->frame_index = frame_index;
+    job->timestamp_us = timestamp_us;
+
+    const size_t count = IFX_CUBE_SIZE(frame);
+    rec_job_state_t state = REC_JOB_QUEUED;
+
+    // frames which aren't plain ADC values are stored as they are
+    if(!rec_codec_quantize(IFX_CUBE_DAT(frame), count, job->q)) {
+        job->out_size = rec_codec_encode_float(dims, IFX_CUBE_DAT(frame), job->out);
+        state = REC_JOB_DONE;
+    }
+
+    pthread_mutex_lock(&s_bin.job_lock);
+    job->state = state;
+    pthread_cond_broadcast(&s_bin.job_changed);
+    pthread_mutex_unlock(&s_bin.job_lock);
+
+    s_bin.job_fill = (s_bin.job_fill + 1) % s_bin.num_jobs;
+
+    return commit_jobs(false);
+}
+
+bool rec_binary_write_frame(const ifx_Cube_R_t *frame)
+{
+    const rec_codec_dims_t dims = {
+        IFX_CUBE_ROWS(frame), IFX_CUBE_COLS(frame), IFX_CUBE_SLICES(frame)
+    };
+    const uint32_t frame_index = s_bin.frame_index++;
+    const uint64_t timestamp_us = now_us();
+
+    if(s_bin.config.compression > 0)
+        return write_frame_coded(&dims, frame_index, timestamp_us, frame);
+
+    return commit_frame(&dims, frame_index, timestamp_us,
+        IFX_CUBE_DAT(frame), IFX_CUBE_SIZE(frame) * sizeof(ifx_Float_t));
+}
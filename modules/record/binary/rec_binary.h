@@ -0,0 +1,78 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file rec_binary.h
+ *
+ * @brief Binary file writer for recordings in the format of
+ *        interface/record_format.h
+ *
+ * Frames are copied into aligned buffers which a writer thread hands to the
+ * kernel, with O_DIRECT if possible, so the caller never waits for the
+ * storage unless all buffers are in flight. Files are preallocated and can
+ * be rotated by size or age. With compression, frames are encoded by a pool
+ * of threads and written in order.
+ */
+
+#ifndef IFX_REC_BINARY_H
+#define IFX_REC_BINARY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ifxBase/Cube.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+typedef struct {
+    uint64_t preallocate_bytes; /**< Space reserved when a file is created, 0 for none */
+    uint64_t rotate_bytes;      /**< Start a new file before exceeding this size, 0 to disable */
+    uint32_t rotate_s;          /**< Start a new file after this many seconds, 0 to disable */
+    bool direct_io;             /**< Bypass the page cache if the file system supports it */
+    uint32_t compression;       /**< 0 stores floats, otherwise the rec_codec_t to encode frames with */
+    uint32_t codec_threads;     /**< Number of threads encoding frames in parallel */
+} rec_binary_config_t;
+
+/* With rotation, files are named <path without extension>-<index>.<extension> */
+extern bool rec_binary_start(const char *path, const rec_binary_config_t *config);
+
+/* Writes all buffered data and closes the file. Returns false if any write failed. */
+extern bool rec_binary_stop();
+
+/* A frame with other dimensions than the current file starts a new file if
+ * rotation is enabled, otherwise it is rejected and false is returned. */
+extern bool rec_binary_write_frame(const ifx_Cube_R_t *frame);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif // IFX_REC_BINARY_H
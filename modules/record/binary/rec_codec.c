@@ -0,0 +1,372 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#include "rec_codec.h"
+
+#include <math.h>
+#include <string.h>
+
+#define RICE_MAX_K          12u
+#define RICE_ESCAPE_ONES    16u
+#define RICE_ESCAPE_BITS    13u     /* zigzag mapped difference of two 12 bit values */
+#define RICE_ROW_START      2048    /* prediction for the very first value */
+
+typedef enum {
+    PRED_CHIRP = 0,
+    PRED_SAMPLE = 1,
+} predictor_t;
+
+typedef struct {
+    uint8_t *p;
+    uint64_t acc;
+    unsigned bits;
+} bit_writer_t;
+
+typedef struct {
+    const uint8_t *p;
+    const uint8_t *end;
+    uint64_t acc;
+    unsigned bits;
+    uint64_t consumed;
+} bit_reader_t;
+
+static inline uint32_t zigzag(int32_t d)
+{
+    return ((uint32_t)d << 1) ^ (uint32_t)(d >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t u)
+{
+    return (int32_t)(u >> 1) ^ -(int32_t)(u & 1);
+}
+
+/* n <= 32 */
+static inline void put_bits(bit_writer_t *w, uint32_t v, unsigned n)
+{
+    w->acc = (w->acc << n) | v;
+    w->bits += n;
+
+    while(w->bits >= 8) {
+        w->bits -= 8;
+        *(w->p++) = (uint8_t)(w->acc >> w->bits);
+    }
+}
+
+static inline void flush_bits(bit_writer_t *w)
+{
+    if(w->bits > 0)
+        *(w->p++) = (uint8_t)(w->acc << (8 - w->bits));
+    w->bits = 0;
+}
+
+/* n <= 32, reading past the end yields zeros, check consumed afterwards */
+static inline uint32_t get_bits(bit_reader_t *r, unsigned n)
+{
+    while(r->bits < n) {
+        r->acc = (r->acc << 8) | ((r->p < r->end) ? *(r->p++) : 0u);
+        r->bits += 8;
+    }
+
+    r->bits -= n;
+    r->consumed += n;
+    return (uint32_t)(r->acc >> r->bits) & (uint32_t)((1ull << n) - 1);
+}
+
+static void residuals(const uint16_t *q, uint32_t row, const rec_codec_dims_t *dims,
+    predictor_t predictor, uint32_t *res)
+{
+    const uint32_t num_chirps = dims->num_chirps_per_frame;
+    const uint16_t *cur = q + (size_t)row * num_chirps;
+
+    if(predictor == PRED_SAMPLE) {
+        const uint16_t *ref = cur - (size_t)dims->num_antennas * num_chirps;
+        for(uint32_t c = 0; c < num_chirps; c++)
+            res[c] = zigzag((int32_t)cur[c] - (int32_t)ref[c]);
+    }
+    else {
+        int32_t prev = (row > 0) ? cur[-(ptrdiff_t)num_chirps] : RICE_ROW_START;
+        for(uint32_t c = 0; c < num_chirps; c++) {
+            res[c] = zigzag((int32_t)cur[c] - prev);
+            prev = cur[c];
+        }
+    }
+}
+
+/* Rice parameter close to the optimum for geometrically distributed values */
+static unsigned estimate_k(const uint32_t *res, uint32_t count)
+{
+    uint64_t sum = 0;
+    for(uint32_t i = 0; i < count; i++)
+        sum += res[i];
+
+    unsigned k = 0;
+    while((k < RICE_MAX_K) && (((uint64_t)count << (k + 1)) <= sum))
+        k++;
+
+    return k;
+}
+
+static uint64_t rice_cost(const uint32_t *res, uint32_t count, unsigned k)
+{
+    uint64_t bits = 0;
+
+    for(uint32_t i = 0; i < count; i++) {
+        const uint32_t quotient = res[i] >> k;
+        bits += (quotient < RICE_ESCAPE_ONES)
+            ? quotient + 1 + k
+            : RICE_ESCAPE_ONES + RICE_ESCAPE_BITS;
+    }
+
+    return bits;
+}
+
+static void rice_put(bit_writer_t *w, const uint32_t *res, uint32_t count, unsigned k)
+{
+    for(uint32_t i = 0; i < count; i++) {
+        const uint32_t u = res[i];
+        const uint32_t quotient = u >> k;
+
+        if(quotient < RICE_ESCAPE_ONES) {
+            put_bits(w, ((1u << quotient) - 1) << 1, quotient + 1);
+            if(k > 0)
+                put_bits(w, u & ((1u << k) - 1), k);
+        }
+        else {
+            put_bits(w, (1u << RICE_ESCAPE_ONES) - 1, RICE_ESCAPE_ONES);
+            put_bits(w, u, RICE_ESCAPE_BITS);
+        }
+    }
+}
+
+static size_t encode_packed12(const uint16_t *q, uint32_t count, uint8_t *out)
+{
+    uint8_t *p = out;
+
+    for(uint32_t i = 0; i < count; i += 2) {
+        const uint16_t a = q[i];
+        const uint16_t b = (i + 1 < count) ? q[i + 1] : 0;
+        *(p++) = (uint8_t)(a >> 4);
+        *(p++) = (uint8_t)(((a & 15) << 4) | (b >> 8));
+        *(p++) = (uint8_t)(b & 0xFF);
+    }
+
+    return (size_t)(p - out);
+}
+
+static size_t encode_rice(const rec_codec_dims_t *dims, bool adaptive, const uint16_t *q, uint8_t *out)
+{
+    const uint32_t num_chirps = dims->num_chirps_per_frame;
+    const uint32_t num_rows = dims->num_antennas * dims->num_samples_per_chirp;
+
+    // one row of residuals per predictor, rows are at most a frame's chirps
+    uint32_t res[2][1024];
+    if(num_chirps > 1024)
+        return 0;
+
+    bit_writer_t w = { out, 0, 0 };
+
+    for(uint32_t row = 0; row < num_rows; row++) {
+        predictor_t best_pred = PRED_CHIRP;
+        residuals(q, row, dims, PRED_CHIRP, res[PRED_CHIRP]);
+        unsigned best_k = estimate_k(res[PRED_CHIRP], num_chirps);
+
+        if(adaptive) {
+            uint64_t best_cost = UINT64_MAX;
+            const int num_pred = (row >= dims->num_antennas) ? 2 : 1;
+
+            if(num_pred > 1)
+                residuals(q, row, dims, PRED_SAMPLE, res[PRED_SAMPLE]);
+
+            for(int pred = 0; pred < num_pred; pred++) {
+                const unsigned k0 = estimate_k(res[pred], num_chirps);
+
+                for(unsigned k = (k0 > 0) ? k0 - 1 : 0; (k <= k0 + 1) && (k <= RICE_MAX_K); k++) {
+                    const uint64_t cost = rice_cost(res[pred], num_chirps, k);
+                    if(cost < best_cost) {
+                        best_cost = cost;
+                        best_pred = (predictor_t)pred;
+                        best_k = k;
+                    }
+                }
+            }
+
+            put_bits(&w, (uint32_t)best_pred, 1);
+        }
+
+        put_bits(&w, best_k, 4);
+        rice_put(&w, res[best_pred], num_chirps, best_k);
+    }
+
+    flush_bits(&w);
+    return (size_t)(w.p - out);
+}
+
+static bool decode_rice(const rec_codec_dims_t *dims, bool adaptive,
+    const uint8_t *in, size_t size, uint16_t *q)
+{
+    const uint32_t num_chirps = dims->num_chirps_per_frame;
+    const uint32_t num_rows = dims->num_antennas * dims->num_samples_per_chirp;
+    bit_reader_t r = { in, in + size, 0, 0, 0 };
+
+    for(uint32_t row = 0; row < num_rows; row++) {
+        const predictor_t pred = adaptive ? (predictor_t)get_bits(&r, 1) : PRED_CHIRP;
+        const unsigned k = get_bits(&r, 4);
+        uint16_t *cur = q + (size_t)row * num_chirps;
+        const uint16_t *ref = NULL;
+        int32_t prev = (row > 0) ? cur[-(ptrdiff_t)num_chirps] : RICE_ROW_START;
+
+        if((k > RICE_MAX_K) || ((pred == PRED_SAMPLE) && (row < dims->num_antennas)))
+            return false;
+        if(pred == PRED_SAMPLE)
+            ref = cur - (size_t)dims->num_antennas * num_chirps;
+
+        for(uint32_t c = 0; c < num_chirps; c++) {
+            uint32_t quotient = 0;
+            while((quotient < RICE_ESCAPE_ONES) && get_bits(&r, 1))
+                quotient++;
+
+            uint32_t u;
+            if(quotient < RICE_ESCAPE_ONES)
+                u = (quotient << k) | ((k > 0) ? get_bits(&r, k) : 0);
+            else
+                u = get_bits(&r, RICE_ESCAPE_BITS);
+
+            const int32_t v = ((pred == PRED_SAMPLE) ? ref[c] : prev) + unzigzag(u);
+            if((v < 0) || (v > 4095))
+                return false;
+
+            cur[c] = (uint16_t)v;
+            prev = v;
+        }
+    }
+
+    return r.consumed <= (uint64_t)size * 8;
+}
+
+/*
+==============================================================================
+   exported functions
+==============================================================================
+*/
+
+bool rec_codec_quantize(const float *in, size_t count, uint16_t *q)
+{
+    for(size_t i = 0; i < count; i++) {
+        const long v = lrintf(in[i] * 4095.0f);
+        if((v < 0) || (v > 4095) || ((float)v / 4095.0f != in[i]))
+            return false;
+        q[i] = (uint16_t)v;
+    }
+
+    return true;
+}
+
+size_t rec_codec_max_size(const rec_codec_dims_t *dims)
+{
+    const size_t count = (size_t)dims->num_antennas * dims->num_chirps_per_frame * dims->num_samples_per_chirp;
+    return sizeof(rec_coded_frame_header_t) + count * sizeof(float) + count / 2 + 16;
+}
+
+size_t rec_codec_encode(const rec_codec_dims_t *dims, rec_codec_t codec,
+    const uint16_t *q, uint8_t *out)
+{
+    const uint32_t count = dims->num_antennas * dims->num_chirps_per_frame * dims->num_samples_per_chirp;
+    rec_coded_frame_header_t header = { (uint8_t)codec, { 0, 0, 0 }, count };
+    uint8_t *data = out + sizeof(header);
+    const size_t packed_size = ((size_t)(count + 1) / 2) * 3;
+    size_t size = 0;
+
+    if((codec == REC_CODEC_RICE) || (codec == REC_CODEC_RICE_ADAPTIVE))
+        size = encode_rice(dims, codec == REC_CODEC_RICE_ADAPTIVE, q, data);
+
+    if((size == 0) || (size >= packed_size)) {
+        header.codec = REC_CODEC_PACKED12;
+        size = encode_packed12(q, count, data);
+    }
+
+    memcpy(out, &header, sizeof(header));
+    return sizeof(header) + size;
+}
+
+size_t rec_codec_encode_float(const rec_codec_dims_t *dims, const float *in, uint8_t *out)
+{
+    const uint32_t count = dims->num_antennas * dims->num_chirps_per_frame * dims->num_samples_per_chirp;
+    const rec_coded_frame_header_t header = { REC_CODEC_FLOAT32, { 0, 0, 0 }, count };
+
+    memcpy(out, &header, sizeof(header));
+    memcpy(out + sizeof(header), in, (size_t)count * sizeof(float));
+    return sizeof(header) + (size_t)count * sizeof(float);
+}
+
+bool rec_codec_decode(const rec_codec_dims_t *dims, const uint8_t *in, size_t size,
+    uint16_t *q, float *out)
+{
+    const uint32_t count = dims->num_antennas * dims->num_chirps_per_frame * dims->num_samples_per_chirp;
+    rec_coded_frame_header_t header;
+
+    if(size < sizeof(header))
+        return false;
+
+    memcpy(&header, in, sizeof(header));
+    in += sizeof(header);
+    size -= sizeof(header);
+
+    if(header.num_values != count)
+        return false;
+
+    if(header.codec == REC_CODEC_FLOAT32) {
+        if(size != (size_t)count * sizeof(float))
+            return false;
+        memcpy(out, in, size);
+        return true;
+    }
+
+    if(header.codec == REC_CODEC_PACKED12) {
+        if(size != ((size_t)(count + 1) / 2) * 3)
+            return false;
+
+        for(uint32_t i = 0; i < count; i += 2, in += 3) {
+            q[i] = (uint16_t)((in[0] << 4) | (in[1] >> 4));
+            if(i + 1 < count)
+                q[i + 1] = (uint16_t)(((in[1] & 15) << 8) | in[2]);
+        }
+    }
+    else if((header.codec == REC_CODEC_RICE) || (header.codec == REC_CODEC_RICE_ADAPTIVE)) {
+        if(!decode_rice(dims, header.codec == REC_CODEC_RICE_ADAPTIVE, in, size, q))
+            return false;
+    }
+    else {
+        return false;
+    }
+
+    for(uint32_t i = 0; i < count; i++)
+        out[i] = (float)q[i] / 4095.0f;
+
+    return true;
+}
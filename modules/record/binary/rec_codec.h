@@ -0,0 +1,93 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file rec_codec.h
+ *
+ * @brief Lossless coding of frames of 12 bit radar samples
+ *
+ * The cube is treated as num_samples * num_antennas rows of num_chirps
+ * values. The Rice codecs predict every value from its neighbour in the
+ * previous chirp (the first value of a row from the first value of the
+ * previous row), or, with REC_CODEC_RICE_ADAPTIVE, optionally from the same
+ * chirp one sample earlier. Residuals are zigzag mapped and Rice coded with
+ * a parameter chosen per row.
+ *
+ * Bitstream, MSB first: per row a header (REC_CODEC_RICE_ADAPTIVE: 1 bit
+ * predictor, 0 = chirp, 1 = sample; then 4 bits Rice parameter k) followed
+ * by the coded residuals. A residual u is written as u >> k one bits, a zero
+ * bit and the k low bits of u. Quotients of 16 and more are escaped as 16
+ * one bits followed by u in 13 bits. The stream is padded to a full byte.
+ */
+
+#ifndef IFX_REC_CODEC_H
+#define IFX_REC_CODEC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "interface/record_format.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+typedef struct {
+    uint32_t num_antennas;
+    uint32_t num_chirps_per_frame;
+    uint32_t num_samples_per_chirp;
+} rec_codec_dims_t;
+
+/* Convert normalized samples back to ADC values. Returns false if any value
+ * isn't exactly q / 4095.0f for a 12 bit q, such frames can't be coded. */
+extern bool rec_codec_quantize(const float *in, size_t count, uint16_t *q);
+
+/* Upper bound of the size of an encoded frame including its header */
+extern size_t rec_codec_max_size(const rec_codec_dims_t *dims);
+
+/* Encode the ADC values of a frame with the given codec, falls back to
+ * REC_CODEC_PACKED12 if that is smaller. Returns the number of bytes
+ * written to out, which must hold rec_codec_max_size() bytes. */
+extern size_t rec_codec_encode(const rec_codec_dims_t *dims, rec_codec_t codec,
+    const uint16_t *q, uint8_t *out);
+
+/* Store a frame which can't be quantized as REC_CODEC_FLOAT32 */
+extern size_t rec_codec_encode_float(const rec_codec_dims_t *dims, const float *in, uint8_t *out);
+
+/* Decode a coded frame of size bytes into normalized samples, q is scratch
+ * space for the ADC values of one frame */
+extern bool rec_codec_decode(const rec_codec_dims_t *dims, const uint8_t *in, size_t size,
+    uint16_t *q, float *out);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif // IFX_REC_CODEC_H
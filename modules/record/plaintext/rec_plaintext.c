@@ -34,21 +34,105 @@
 
 #include "interface/record.h"
 #include "interface/report.h"
+#include "interface/record_format.h"
+#include "../binary/rec_binary.h"
 #include <stdio.h>
+#include <string.h>
 
 static const char* record_file_path = NULL;
 static FILE* s_file = NULL;
+static bool s_binary = false;
+static bool s_binary_running = false;
+static rec_binary_config_t s_binary_config = { 0, 0, 0, true, 0, 2 };
 
 static bool set_recfile(const char *v) {
     record_file_path = v;
     return true;
 }
 
+static bool set_format(const char *v) {
+    if (strcmp(v, "text") == 0)
+        s_binary = false;
+    else if (strcmp(v, "binary") == 0)
+        s_binary = true;
+    else {
+        rep_err("Recording format '%s' not understood.\n", v);
+        return false;
+    }
+    return true;
+}
+
+static bool set_preallocate(int v) {
+    s_binary_config.preallocate_bytes = (v > 0) ? (uint64_t)v << 20 : 0;
+    return true;
+}
+
+static bool set_rotate_size(int v) {
+    s_binary_config.rotate_bytes = (v > 0) ? (uint64_t)v << 20 : 0;
+    return true;
+}
+
+static bool set_rotate_time(int v) {
+    s_binary_config.rotate_s = (v > 0) ? (uint32_t)v : 0;
+    return true;
+}
+
+static bool set_direct_io(bool v) {
+    s_binary_config.direct_io = v;
+    return true;
+}
+
+static bool set_compression(int v) {
+    if ((v < 0) || (v > REC_CODEC_RICE_ADAPTIVE)) {
+        rep_err("Compression level must be between 0 and %d.\n", (int)REC_CODEC_RICE_ADAPTIVE);
+        return false;
+    }
+    s_binary_config.compression = (uint32_t)v;
+    return true;
+}
+
+static bool set_codec_threads(int v) {
+    if (v <= 0) {
+        rep_err("Number of encoder threads must be positive.\n");
+        return false;
+    }
+    s_binary_config.codec_threads = (uint32_t)v;
+    return true;
+}
+
 static const app_option_t recording_options[] = {
     APP_OPTION_PATH(
         "file",
         "file to which to record the sensor data",
         set_recfile),
+    APP_OPTION_STRING(
+        "format",
+        "text or binary (see interface/record_format.h)",
+        set_format),
+    APP_OPTION_INT(
+        "preallocate_mb",
+        "binary: space to reserve for the file in MiB",
+        set_preallocate),
+    APP_OPTION_INT(
+        "rotate_mb",
+        "binary: start a new file when this size in MiB is reached",
+        set_rotate_size),
+    APP_OPTION_INT(
+        "rotate_s",
+        "binary: start a new file after this many seconds",
+        set_rotate_time),
+    APP_OPTION_BOOL(
+        "direct_io",
+        "binary: bypass the page cache (default true)",
+        set_direct_io),
+    APP_OPTION_INT(
+        "compression",
+        "binary: 0 none, 1 12 bit packing, 2 chirp delta + rice, 3 adaptive delta + rice",
+        set_compression),
+    APP_OPTION_INT(
+        "codec_threads",
+        "binary: number of threads compressing frames (default 2)",
+        set_codec_threads),
     APP_OPTION_END
 };
 
@@ -66,6 +150,12 @@ void record_deinit()
 
 void record_stop()
 {
+	if (s_binary_running) {
+		if (!rec_binary_stop())
+			rep_err("Recording data to file failed.\n");
+		s_binary_running = false;
+	}
+
 	if (s_file != NULL) {
 		fclose(s_file);
 		s_file = NULL;
@@ -79,6 +169,11 @@ bool record_start()
 	if(record_file_path == NULL)
 		return true;
 
+	if (s_binary) {
+		s_binary_running = rec_binary_start(record_file_path, &s_binary_config);
+		return s_binary_running;
+	}
+
 	s_file = fopen(record_file_path, "w");
 
 	if (s_file == NULL)
@@ -92,7 +187,7 @@ bool record_start()
 
 static bool record_ing()
 {
-	return (s_file != NULL);
+	return (s_file != NULL) || s_binary_running;
 }
 
 extern bool record_radar_frame(ifx_Cube_R_t* frame)
@@ -100,6 +195,12 @@ extern bool record_radar_frame(ifx_Cube_R_t* frame)
 	if (!record_ing())
 		return true;
 
+	if (s_binary_running) {
+		if (rec_binary_write_frame(frame))
+			return true;
+		goto write_error;
+	}
+
 	FILE *f = s_file;
 
 	const uint32_t nAnt = IFX_CUBE_ROWS(frame);
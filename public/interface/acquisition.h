@@ -42,6 +42,7 @@
 #define IFX_ACQUISITION_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "ifxBase/Cube.h"
 #include "interface/app_utils.h"
 #include "interface/app_argparse.h"
@@ -60,6 +61,13 @@ extern void acq_deinit();
 extern bool acq_start();
 extern void acq_stop();
 extern bool acq_fetch(ifx_Cube_R_t **out);
+/* Fetch a frame which stays valid until it is given back with acq_release().
+ * At most the number of frames set with acq_set_max_held_frames() can be
+ * held at the same time. */
+extern bool acq_fetch_hold(ifx_Cube_R_t **out);
+extern void acq_release(ifx_Cube_R_t *frame);
+/* Set before acq_start() */
+extern bool acq_set_max_held_frames(uint32_t num_frames);
 
 #ifdef __cplusplus
 } // extern "C"
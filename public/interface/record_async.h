@@ -0,0 +1,80 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file record_async.h
+ *
+ * @brief Runs the recording on its own thread, so slow storage doesn't hold
+ *        up fetching frames from the acquisition.
+ *
+ * Frames are passed by reference through a bounded queue. They are fetched
+ * with acq_fetch_hold() and handed back with acq_release() once they have
+ * been recorded or dropped.
+ */
+
+#ifndef IFX_RECORD_ASYNC_H
+#define IFX_RECORD_ASYNC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ifxBase/Cube.h"
+#include "interface/app_argparse.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+extern const app_cmdarg_t rec_async_adesc;
+
+extern void record_async_init();
+
+extern void record_async_deinit();
+
+/* True if the recording should run asynchronously */
+extern bool record_async_enabled();
+
+/* Number of frames which are held at most at the same time, i.e. the
+ * queue depth plus the frame being written plus the frame being submitted */
+extern uint32_t record_async_max_held_frames();
+
+extern bool record_async_start();
+
+/* Writes all queued frames and stops the recording thread */
+extern void record_async_stop();
+
+/* Queue a frame fetched with acq_fetch_hold() for recording. The frame is
+ * owned by the recorder afterwards. Returns false if recording failed. */
+extern bool record_async_submit(ifx_Cube_R_t *frame);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif // IFX_RECORD_ASYNC_H
@@ -0,0 +1,102 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file record_format.h
+ *
+ * @brief Layout of binary recordings.
+ *
+ * A recording consists of one or more files. Each file starts with a
+ * rec_file_header_t, padded to header_size bytes, followed by frames. Every
+ * frame is a rec_frame_header_t followed by frame_size bytes of frame data.
+ * With REC_SAMPLE_FLOAT32 the frame data is the cube as returned by the
+ * acquisition, num_samples_per_chirp x num_antennas x num_chirps_per_frame
+ * floats. With REC_SAMPLE_CODED it is a rec_coded_frame_header_t followed by
+ * the frame in the encoding named there. All values are little endian.
+ */
+
+#ifndef IFX_RECORD_FORMAT_H
+#define IFX_RECORD_FORMAT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+#define REC_FORMAT_MAGIC        "RDRB"
+#define REC_FORMAT_VERSION      1u
+#define REC_FORMAT_HEADER_SIZE  4096u
+
+typedef enum {
+    REC_SAMPLE_FLOAT32 = 0u,    /**< Normalized samples as 32 bit floats */
+    REC_SAMPLE_CODED = 1u,      /**< Frames start with a rec_coded_frame_header_t */
+} rec_sample_format_t;
+
+/* Encodings of coded frames. All but REC_CODEC_FLOAT32 store the 12 bit ADC
+ * values q, which are decoded as q / 4095.0f. Frames which aren't plain
+ * ADC values, e.g. because of calibration, are stored as REC_CODEC_FLOAT32.
+ * Every frame can be decoded on its own. */
+typedef enum {
+    REC_CODEC_FLOAT32 = 0u,     /**< Same as REC_SAMPLE_FLOAT32 */
+    REC_CODEC_PACKED12 = 1u,    /**< Two values in three bytes, first value in the upper 12 bits */
+    REC_CODEC_RICE = 2u,        /**< Rice coded differences between neighbouring chirps */
+    REC_CODEC_RICE_ADAPTIVE = 3u, /**< Rice coded differences, predictor chosen per row */
+} rec_codec_t;
+
+typedef struct {
+    uint8_t codec;                  /**< rec_codec_t */
+    uint8_t reserved[3];
+    uint32_t num_values;            /**< Number of samples in the frame */
+} rec_coded_frame_header_t;
+
+typedef struct {
+    char magic[4];                  /**< REC_FORMAT_MAGIC */
+    uint32_t version;               /**< REC_FORMAT_VERSION */
+    uint32_t header_size;           /**< Offset of the first frame in the file */
+    uint32_t sample_format;         /**< rec_sample_format_t */
+    uint32_t num_antennas;
+    uint32_t num_chirps_per_frame;
+    uint32_t num_samples_per_chirp;
+    uint32_t file_index;            /**< Position of the file in a rotated recording */
+    uint64_t start_time_us;         /**< Wall clock time the file was started in us since the epoch */
+} rec_file_header_t;
+
+typedef struct {
+    uint32_t frame_size;            /**< Bytes of frame data following the header */
+    uint32_t frame_index;           /**< Counts frames across all files of a recording */
+    uint64_t timestamp_us;          /**< Wall clock time the frame was recorded in us since the epoch */
+} rec_frame_header_t;
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif // IFX_RECORD_FORMAT_H